@@ -0,0 +1,30 @@
+#pragma once
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "multi_start_insertion_tsp.h"
+#include "random_generator.h"
+
+using namespace random_generator;
+
+// Cheapest Insertion: start from a random node i and the node j that minimizes δ(i, j), then
+// repeatedly select the node k not in circuit and the arc (i, j) of the circuit that minimize
+// w(i, k) + w(k, j) - w(i, j), and insert k in between i and j.
+// Time: about O(n^2.5) on uniform random points, O(n^3) in the worst case.
+//       See insertion::select_cheapest.
+[[nodiscard]] inline int cheapest_insertion_tsp(DistanceMatrix<int>& distance_matrix,
+                                                RandomGenerator<size_t>& rand_int,
+                                                const improvement::Stage stage) noexcept {
+    return insertion::insertion_tsp<insertion::select_cheapest>(
+        distance_matrix, insertion::seed_random_closest(rand_int), stage);
+}
+
+// Multi-start Cheapest Insertion: run Cheapest Insertion from n_starts distinct start nodes on
+// every CPU core, and return the weight of the best circuit found.
+[[nodiscard]] inline int cheapest_insertion_multi_start_tsp(DistanceMatrix<int>& distance_matrix,
+                                                            const size_t n_starts,
+                                                            const improvement::Stage stage) {
+    return insertion::multi_start_insertion_tsp<insertion::select_cheapest>(
+        distance_matrix, n_starts, stage);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <vector>  // std::vector
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "point.h"
+
+// Convex Hull Insertion: start from the convex hull of the points, then repeatedly select the node
+// k not in circuit and the arc (i, j) of the circuit that minimize w(i, k) + w(k, j) - w(i, j),
+// and insert k in between i and j.
+[[nodiscard]] inline int convex_hull_insertion_tsp(DistanceMatrix<int>& distance_matrix,
+                                                   const std::vector<point::point_2D>& points,
+                                                   const improvement::Stage stage) {
+    return insertion::insertion_tsp<insertion::select_cheapest>(
+        distance_matrix, insertion::seed_convex_hull(points), stage);
+}
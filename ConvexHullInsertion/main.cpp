@@ -0,0 +1,43 @@
+#include <iostream>  // std::cout, std::endl
+
+#include "convex_hull_insertion_tsp.h"
+#include "DistanceMatrix.h"
+#include "EuclideanPointReader.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "random_generator.h"
+#include "read_file.h"
+
+int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
+    if (argc != 2) {
+        std::cerr << "1 argument required: filename. Optional flags: " << improvement::flags_usage
+                  << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+    auto distance_matrix = point_reader->create_distance_matrix();
+
+    // the convex hull is only defined for EUC_2D points. GEO instances fall back to Cheapest
+    // Insertion from a random node and its closest node.
+    const auto* euclidean_reader =
+        dynamic_cast<const point_reader::EuclideanPointReader*>(point_reader.get());
+
+    int total_weight;
+    if (euclidean_reader != nullptr) {
+        // calculate the weight of TSP with Convex Hull Insertion heuristic
+        total_weight =
+            convex_hull_insertion_tsp(distance_matrix, euclidean_reader->points(), stage);
+    } else {
+        random_generator::IntegerRandomGenerator rand_int(0, distance_matrix.size() - 1);
+        total_weight = insertion::insertion_tsp<insertion::select_cheapest>(
+            distance_matrix, insertion::seed_random_closest(rand_int), stage);
+    }
+
+    // use std::fixed to avoid displaying numbers in scientific notation
+    std::cout << std::fixed << total_weight << std::endl;
+}
@@ -1,16 +1,25 @@
 #include <iostream>  // std::cout, std::endl
+#include <optional>  // std::optional
 
-// #include "parallel_executor.h"
 #include "DistanceMatrix.h"
 #include "farthest_insertion_tsp.h"
+#include "improvement.h"
 #include "random_generator.h"
 #include "read_file.h"
 #include "sequential_executor.h"
 #include "shared_utils.h"
 
 int main(int argc, char** argv) {
-    if (argc != 2) {
-        std::cerr << "1 argument required: filename" << std::endl;
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
+    // number of distinct start nodes, which must be a positive integer
+    const std::optional<size_t> n_starts_opt =
+        argc == 3 ? utils::parse_count(argv[2]) : std::optional<size_t>(1);
+
+    if ((argc != 2 && argc != 3) || !n_starts_opt.has_value()) {
+        std::cerr << "1 argument required: filename. Optional argument: number of start nodes. "
+                  << "Optional flags: " << improvement::flags_usage << std::endl;
         exit(0);
     }
 
@@ -18,6 +27,19 @@ int main(int argc, char** argv) {
     auto point_reader(read_file(filename));
     auto distance_matrix = point_reader->create_distance_matrix();
 
+    // number of distinct start nodes, clamped to the number of nodes in the graph
+    const size_t n_starts = n_starts_opt.value();
+
+    if (n_starts > 1) {
+        // run Farthest Insertion from n_starts distinct start nodes on every CPU core
+        const int total_weight =
+            farthest_insertion_multi_start_tsp(distance_matrix, n_starts, stage);
+
+        // use std::fixed to avoid displaying numbers in scientific notation
+        std::cout << std::fixed << total_weight << std::endl;
+        return 0;
+    }
+
     // Generate a random source node for the Hamiltonian cycle found with the Farthest Insertion
     // heuristic. If you'd rather started from a fixed node (e.g. 0), just substitute the following
     // line with `random_generator::FixedGenerator<size_t> rand_int(0);`.
@@ -25,15 +47,12 @@ int main(int argc, char** argv) {
 
     // calculate the weight of TSP with Farthest Insertion heuristic
     auto solve_tsp = [&]() {
-        return farthest_insertion_tsp(distance_matrix, rand_int);
+        return farthest_insertion_tsp(distance_matrix, rand_int, stage);
     };
 
     // run Farthest Insertion only once
     const auto executor(executor::sequential_executor(1, std::move(solve_tsp)));
 
-    // run Farthest Insertion as many times as the number of CPU cores
-    // const auto executor(executor::parallel_executor({}, std::move(solve_tsp)));
-
     // save the best cost found
     const int total_weight = executor.get_best_result(utils::min_element);
 
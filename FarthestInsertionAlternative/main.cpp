@@ -2,12 +2,17 @@
 
 #include "DistanceMatrix.h"
 #include "farthest_insertion_alternative_tsp.h"
+#include "improvement.h"
 #include "parallel_executor.h"
 #include "read_file.h"
 
 int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
     if (argc != 2) {
-        std::cerr << "1 argument required: filename" << std::endl;
+        std::cerr << "1 argument required: filename. Optional flags: " << improvement::flags_usage
+                  << std::endl;
         exit(0);
     }
 
@@ -17,7 +22,7 @@ int main(int argc, char** argv) {
 
     // calculate the weight of TSP with the alternative Farthest Insertion heuristic
     const auto total_weight =
-        farthest_insertion_alt_tsp(std::forward<decltype(distance_matrix)>(distance_matrix));
+        farthest_insertion_alt_tsp(std::forward<decltype(distance_matrix)>(distance_matrix), stage);
 
     // use std::fixed to avoid displaying numbers in scientific notation
     std::cout << std::fixed << total_weight << std::endl;
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>  // std::min
+#include <limits>     // std::numeric_limits
+#include <vector>     // std::vector
+
+#include "IndexedPriorityQueue.h"
+#include "LinkedTour.h"
+#include "SpatialGrid.h"
+#include "euclidean_distance.h"
+#include "improvement.h"
+#include "nearest_neighbors.h"
+#include "point.h"
+#include "random_generator.h"
+
+using namespace random_generator;
+
+namespace detail {
+    // collect in neighbors the points v around p that satisfy pred(v). The grid rings are visited
+    // from the cell of p outwards, and the search stops one ring after the one in which the
+    // min_count-th point has been found, so that the points just outside of that ring, which
+    // may be closer than the ones already found, are considered too.
+    template <typename Predicate>
+    void collect_neighbors(const SpatialGrid& grid, const point::point_2D& p,
+                           const size_t min_count, Predicate&& pred,
+                           std::vector<size_t>& neighbors) {
+        neighbors.clear();
+
+        const size_t max_ring = grid.max_ring();
+        size_t last_ring = max_ring;
+        for (size_t ring = 0; ring <= last_ring && !grid.is_past_grid(p, ring); ++ring) {
+            grid.for_each_in_ring(p, ring, [&](const size_t v) {
+                if (pred(v)) {
+                    neighbors.push_back(v);
+                }
+            });
+
+            if (last_ring == max_ring && neighbors.size() >= min_count) {
+                last_ring = ring + 1;
+            }
+        }
+    }
+}  // namespace detail
+
+/**
+ * Farthest Insertion for large EUC_2D instances, where the O(n^2) distance matrix doesn't fit in
+ * memory. The points are indexed by a SpatialGrid, and distances are computed on the fly.
+ * - δ(k, circuit) is kept in an indexed Max Heap, so the farthest node is selected in O(log n).
+ *   After k is inserted, only the not visited nodes within δ(k, circuit) from k can get closer
+ *   to the circuit, so they are found with a radius query instead of scanning every node.
+ * - k is inserted in the cheapest arc among the ones adjacent to the n_candidates circuit nodes
+ *   closest to k, rather than in the cheapest arc of the whole circuit.
+ * Since farthest nodes are spread over the plane, the radius of the queries shrinks as the
+ * circuit grows, and the expected time on uniformly distributed points is O(n log n).
+ *
+ * @param points the 2D Euclidean points of the graph.
+ * @param rand_int random generator that returns the first node of the circuit.
+ * @param stage optional improvement stage applied to the circuit built. Its candidate lists are
+ *              computed with a SpatialGrid too.
+ * @param n_candidates minimum number of circuit nodes around k whose adjacent arcs are
+ *                     considered for the insertion of k.
+ */
+[[nodiscard]] inline int farthest_insertion_grid_tsp(const std::vector<point::point_2D>& points,
+                                                     RandomGenerator<size_t>& rand_int,
+                                                     const improvement::Stage stage,
+                                                     const size_t n_candidates = 8) {
+    const size_t size = points.size();
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&points](const size_t x, const size_t y) {
+        return distance::euclidean_distance(points[x], points[y]);
+    };
+
+    const SpatialGrid grid(points);
+    std::vector<size_t> neighbors;
+
+    // Step 1: start from a random node i and the node j that minimizes δ(i, j)
+    const size_t first_node = rand_int();
+    detail::collect_neighbors(
+        grid, points[first_node], 1, [first_node](const size_t v) { return v != first_node; },
+        neighbors);
+
+    std::vector<size_t> seeds{first_node};
+    if (!neighbors.empty()) {
+        size_t second_node = neighbors.front();
+        for (const size_t v : neighbors) {
+            if (get_distance(first_node, v) < get_distance(first_node, second_node)) {
+                second_node = v;
+            }
+        }
+        seeds.push_back(second_node);
+    }
+
+    LinkedTour tour(size, seeds);
+
+    // keep track of δ(k, circuit) for every node k not in the partial Hamiltonian circuit
+    auto max_pq = priority_queue::make_max_indexed_priority_queue<int>(size);
+    for (size_t u = 0; u < size; ++u) {
+        if (!tour.contains(u)) {
+            int delta = std::numeric_limits<int>::max();
+            for (const size_t h : seeds) {
+                delta = std::min(delta, get_distance(u, h));
+            }
+            max_pq.push(delta, u);
+        }
+    }
+
+    // Step 2: repeat the insertion until all nodes have been inserted into the circuit
+    while (!max_pq.empty()) {
+        // select the node k not in circuit that maximizes δ(k, circuit)
+        const auto [radius, k] = max_pq.top_key_value();
+        max_pq.pop();
+
+        // insert k in the cheapest arc adjacent to the circuit nodes closest to k
+        detail::collect_neighbors(
+            grid, points[k], n_candidates, [&tour](const size_t v) { return tour.contains(v); },
+            neighbors);
+
+        int min_cost = std::numeric_limits<int>::max();
+        size_t min_i = neighbors.front();
+        for (const size_t h : neighbors) {
+            const size_t prev = tour.prev(h);
+            const size_t next = tour.next(h);
+
+            const int cost_before = get_distance(prev, k) + get_distance(k, h) -
+                                    get_distance(prev, h);
+            const int cost_after = get_distance(h, k) + get_distance(k, next) -
+                                   get_distance(h, next);
+
+            if (cost_before < min_cost) {
+                min_cost = cost_before;
+                min_i = prev;
+            }
+            if (cost_after < min_cost) {
+                min_cost = cost_after;
+                min_i = h;
+            }
+        }
+
+        tour.insert_after(min_i, k);
+
+        // every node u not in circuit has δ(u, circuit) <= radius, so w(u, k) can only improve
+        // it if u is within radius from k
+        grid.for_each_in_radius(points[k], radius, [&](const size_t u) {
+            if (max_pq.contains(u)) {
+                const int weight = get_distance(u, k);
+                if (weight < max_pq.key_at(u)) {
+                    max_pq.update_key(weight, u);
+                }
+            }
+        });
+    }
+
+    // return the weights in the circuit, unrolled in O(n), after the optional improvement stage
+    std::vector<size_t> circuit(tour.to_vector());
+    return improvement::improve_circuit(
+        stage, get_distance,
+        [&points]() {
+            return neighbors::k_nearest_neighbors(points, improvement::n_neighbors);
+        },
+        circuit);
+}
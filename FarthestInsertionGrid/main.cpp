@@ -0,0 +1,61 @@
+#include <iostream>  // std::cout, std::endl
+
+#include "EuclideanPointReader.h"
+#include "farthest_insertion_grid_tsp.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "random_generator.h"
+#include "read_file.h"
+#include "sequential_executor.h"
+#include "shared_utils.h"
+
+int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
+    if (argc != 2) {
+        std::cerr << "1 argument required: filename. Optional flags: " << improvement::flags_usage
+                  << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+
+    // the spatial grid only supports EUC_2D points. GEO instances fall back to the Farthest
+    // Insertion heuristic based on the distance matrix.
+    const auto* euclidean_reader =
+        dynamic_cast<const point_reader::EuclideanPointReader*>(point_reader.get());
+
+    if (euclidean_reader == nullptr) {
+        auto distance_matrix = point_reader->create_distance_matrix();
+        random_generator::IntegerRandomGenerator rand_int(0, distance_matrix.size() - 1);
+
+        const int total_weight = insertion::insertion_tsp<insertion::select_farthest>(
+            distance_matrix, insertion::seed_random_closest(rand_int), stage);
+
+        std::cout << std::fixed << total_weight << std::endl;
+        return 0;
+    }
+
+    const auto& points = euclidean_reader->points();
+
+    // Generate a random source node for the Hamiltonian cycle found with the Farthest Insertion
+    // heuristic. If you'd rather started from a fixed node (e.g. 0), just substitute the following
+    // line with `random_generator::FixedGenerator<size_t> rand_int(0);`.
+    random_generator::IntegerRandomGenerator rand_int(0, points.size() - 1);
+
+    // calculate the weight of TSP with the grid-based Farthest Insertion heuristic
+    auto solve_tsp = [&]() {
+        return farthest_insertion_grid_tsp(points, rand_int, stage);
+    };
+
+    // run Farthest Insertion only once
+    const auto executor(executor::sequential_executor(1, std::move(solve_tsp)));
+
+    // save the best cost found
+    const int total_weight = executor.get_best_result(utils::min_element);
+
+    // use std::fixed to avoid displaying numbers in scientific notation
+    std::cout << std::fixed << total_weight << std::endl;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>  // std::min
+#include <chrono>     // std::chrono
+#include <limits>     // std::numeric_limits
+#include <optional>   // std::optional
+#include <vector>     // std::vector
+
+#include "ArrayTour.h"
+#include "DistanceMatrix.h"
+#include "insertion_policies.h"
+#include "insertion_tsp.h"
+#include "nearest_neighbors.h"
+#include "parallel_executor.h"
+#include "random_generator.h"
+#include "shared_utils.h"
+#include "two_opt.h"
+
+/**
+ * GRASP (Greedy Randomized Adaptive Search Procedure) for the Metric-TSP.
+ * Every iteration builds a tour with a randomized Farthest Insertion, whose next node is picked
+ * uniformly from the restricted candidate list of the nodes whose distance from the circuit is
+ * within alpha of the farthest one (see insertion::select_farthest_rcl), and then improves it
+ * with 2-opt on the k nearest neighbors until it's a local optimum.
+ * Every CPU core runs independent iterations until time_limit expires, and each worker owns its
+ * insertion engine, tour and 2-opt workspace, so no memory is allocated after the first
+ * iteration. Only the nearest neighbor lists are shared, read-only.
+ * Return the weight of the best circuit found.
+ * Time: O(n^2) per iteration for the construction, plus the local search.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param time_limit every worker stops starting new iterations after this time.
+ * @param alpha greediness of the construction, in [0, 1]. 0 is Farthest Insertion.
+ * @param k number of nearest neighbors of each node considered by 2-opt.
+ * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core is
+ *                      used.
+ */
+[[nodiscard]] inline int grasp_tsp(const DistanceMatrix<int>& distance_matrix,
+                                   const std::chrono::milliseconds time_limit,
+                                   const double alpha = 0.1, const size_t k = 10,
+                                   std::optional<size_t>&& n_workers_opt = {}) {
+    const size_t size = distance_matrix.size();
+    const auto deadline = std::chrono::steady_clock::now() + time_limit;
+    const auto neighbors = neighbors::k_nearest_neighbors(distance_matrix, k);
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const auto unbounded = []() noexcept {
+        return std::numeric_limits<int>::max();
+    };
+
+    auto worker = [&]() {
+        random_generator::IntegerRandomGenerator rand_int(0, size - 1);
+        insertion::InsertionEngine<insertion::select_farthest_rcl> engine(distance_matrix, alpha);
+        local_search::TwoOpt two_opt(get_distance, neighbors);
+        ArrayTour tour(size);
+
+        // buffers reused by every iteration
+        std::vector<size_t> seeds(2);
+        std::vector<size_t> circuit;
+        circuit.reserve(size);
+
+        int best_cost = std::numeric_limits<int>::max();
+        do {
+            // Step 1: randomized construction, seeded as in insertion::seed_random_closest
+            seeds[0] = rand_int();
+            seeds[1] = distance_matrix.get_closest_node(seeds[0]);
+            const int cost = *engine.run(seeds, unbounded);
+
+            // Step 2: local search
+            engine.get_tour().copy_to(circuit, seeds[0]);
+            tour.assign(circuit);
+            best_cost = std::min(best_cost, cost - two_opt.optimize(tour));
+        } while (std::chrono::steady_clock::now() < deadline);
+
+        return best_cost;
+    };
+
+    const auto executor(executor::parallel_executor(std::move(n_workers_opt), std::move(worker)));
+
+    return executor.get_best_result(utils::min_element);
+}
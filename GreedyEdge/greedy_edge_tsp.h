@@ -0,0 +1,15 @@
+#pragma once
+
+#include <vector>  // std::vector
+
+#include "DistanceMatrix.h"
+#include "greedy_edge.h"
+#include "improvement.h"
+
+// Greedy Edge: repeatedly add the shortest edge that keeps every node with degree at most 2 and
+// doesn't close a cycle before every node has been reached, then close the Hamiltonian path.
+[[nodiscard]] inline int greedy_edge_tsp(const DistanceMatrix<int>& distance_matrix,
+                                         const improvement::Stage stage) {
+    std::vector<size_t> circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    return improvement::improve_circuit(stage, distance_matrix, circuit);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>  // uint64_t
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+#include "edge_hash.h"
+
+namespace gls {
+    /**
+     * PenaltyTable maps the undirected edges penalized so far to their penalty, which is 0 for
+     * every other edge. Only the penalized edges are stored, in an open addressing hash table
+     * with linear probing keyed by edge_hash::edge_key, so a lookup takes O(1) expected time and
+     * the memory is proportional to the number of penalized edges instead of n^2.
+     * The table doubles its capacity when it gets half full.
+     */
+    class PenaltyTable {
+        // key of the empty slots, which isn't the key of any edge
+        static constexpr uint64_t empty = 0;
+
+        // keys[i] is the key of the edge stored in slot i, whose penalty is penalties[i]
+        std::vector<uint64_t> keys;
+        std::vector<int> penalties;
+
+        // number of edges stored
+        size_t count = 0;
+
+        // capacity minus 1, which is a power of 2 minus 1
+        size_t mask;
+
+        // return the slot of key, or the empty slot where it would be stored
+        [[nodiscard]] size_t find(const uint64_t key) const noexcept {
+            size_t i = static_cast<size_t>(key) & mask;
+            while (keys[i] != key && keys[i] != empty) {
+                i = (i + 1) & mask;
+            }
+
+            return i;
+        }
+
+        // double the capacity and store the edges again
+        // Time: O(capacity)
+        void grow() {
+            const std::vector<uint64_t> old_keys(std::move(keys));
+            const std::vector<int> old_penalties(std::move(penalties));
+            keys.assign(2 * old_keys.size(), empty);
+            penalties.assign(2 * old_keys.size(), 0);
+            mask = keys.size() - 1;
+
+            for (size_t i = 0; i < old_keys.size(); ++i) {
+                if (old_keys[i] != empty) {
+                    const size_t slot = find(old_keys[i]);
+                    keys[slot] = old_keys[i];
+                    penalties[slot] = old_penalties[i];
+                }
+            }
+        }
+
+    public:
+        // create an empty table with room for about capacity / 2 edges before growing
+        explicit PenaltyTable(const size_t capacity) {
+            size_t slots = 16;
+            while (slots < capacity) {
+                slots *= 2;
+            }
+
+            keys.assign(slots, empty);
+            penalties.assign(slots, 0);
+            mask = slots - 1;
+        }
+
+        // return the penalty of the edge (u, v)
+        [[nodiscard]] int at(const size_t u, const size_t v) const noexcept {
+            return penalties[find(edge_hash::edge_key(u, v))];
+        }
+
+        // increase by 1 the penalty of the edge (u, v)
+        // Time: O(1) amortized
+        void increment(const size_t u, const size_t v) {
+            const uint64_t key = edge_hash::edge_key(u, v);
+            size_t slot = find(key);
+            if (keys[slot] == empty) {
+                if (2 * (count + 1) > keys.size()) {
+                    grow();
+                    slot = find(key);
+                }
+
+                keys[slot] = key;
+                ++count;
+            }
+
+            ++penalties[slot];
+        }
+
+        // return the number of edges whose penalty isn't 0
+        [[nodiscard]] size_t size() const noexcept {
+            return count;
+        }
+    };
+}  // namespace gls
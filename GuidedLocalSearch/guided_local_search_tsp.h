@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <chrono>     // std::chrono
+#include <cmath>      // std::lround
+#include <optional>   // std::optional
+#include <vector>     // std::vector
+
+#include "ArrayTour.h"
+#include "DistanceMatrix.h"
+#include "PenaltyTable.h"
+#include "TwoLevelList.h"
+#include "greedy_edge.h"
+#include "improvement.h"
+#include "nearest_neighbors.h"
+#include "or_opt.h"
+#include "parallel_executor.h"
+#include "shared_utils.h"
+#include "two_opt.h"
+
+// weight of a penalty, as a fraction of the average edge weight of the first local optimum
+constexpr double penalty_factor = 0.3;
+
+/**
+ * Guided Local Search for the Metric-TSP, starting from the Greedy Edge circuit. Every CPU core
+ * runs its own search until time_limit expires: 2-opt and Or-opt on the k nearest neighbors of
+ * every node minimize the augmented weight of the circuit, where an edge (u, v) weighs
+ * d(u, v) + lambda * p(u, v). At every local optimum, the penalty p of the circuit edges with
+ * the highest utility d / (1 + p) is increased by 1, and the local search restarts from their
+ * endpoints only, so long expensive edges are pushed out of the circuit without random moves.
+ * The penalties are stored in a gls::PenaltyTable, and the real weight of the circuit is
+ * computed at every local optimum, while looking for the edges to penalize.
+ * Return the weight of the best circuit found.
+ * Time: O(n^2 log k) for the neighbor lists, plus O(n) per local optimum for the penalties and
+ *       the local searches.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param time_limit every worker stops penalizing edges after this time.
+ * @param k number of nearest neighbors of each node considered by the local search.
+ * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core is
+ *                      used.
+ */
+[[nodiscard]] inline int guided_local_search_tsp(const DistanceMatrix<int>& distance_matrix,
+                                                 const std::chrono::milliseconds time_limit,
+                                                 const size_t k = improvement::n_neighbors,
+                                                 std::optional<size_t>&& n_workers_opt = {}) {
+    constexpr auto stage = improvement::Stage::two_opt_or_opt;
+
+    const size_t size = distance_matrix.size();
+    const auto deadline = std::chrono::steady_clock::now() + time_limit;
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const std::vector<size_t> greedy_circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    const int greedy_cost =
+        utils::sum_weights_as_circuit(greedy_circuit.cbegin(), greedy_circuit.cend(), get_distance);
+
+    // every move needs 2 edges that don't share a node
+    if (size < 4) {
+        return greedy_cost;
+    }
+
+    const auto neighbors = neighbors::k_nearest_neighbors(distance_matrix, k);
+
+    auto worker = [&]() {
+        gls::PenaltyTable penalties(size);
+
+        // weight of a penalty, which is 0 until the first local optimum is found
+        int lambda = 0;
+
+        // lambda function that returns the augmented distance between any 2 nodes
+        const auto get_augmented_distance = [&](const size_t x, const size_t y) {
+            return distance_matrix.at(x, y) + lambda * penalties.at(x, y);
+        };
+
+        // the neighbor lists are sorted by the real distance, which is a lower bound of the
+        // augmented one, so the searches stop their scans on the real distance. Otherwise a
+        // penalized near neighbor would hide the farther ones, which are the way out of the
+        // local optimum.
+        local_search::TwoOpt two_opt(get_augmented_distance, get_distance, neighbors);
+        local_search::OrOpt or_opt(get_augmented_distance, get_distance, neighbors);
+
+        // endpoints of the edges penalized at the last local optimum
+        std::vector<size_t> penalized;
+        penalized.reserve(size);
+
+        // run the search on tour, and return the weight of the best circuit found
+        const auto search = [&](auto& tour) {
+            tour.assign(greedy_circuit);
+            improvement::optimize_tour(stage, two_opt, or_opt, tour);
+
+            int best_cost = greedy_cost;
+            while (true) {
+                // the real weight of the circuit and the highest utility d / (1 + p) of its
+                // edges, compared as fractions to avoid rounding
+                int cost = 0;
+                int max_d = 0;
+                int max_p = 0;
+                for (size_t i = 0, u = 0; i < size; ++i, u = tour.next(u)) {
+                    const size_t v = tour.next(u);
+                    const int d = distance_matrix.at(u, v);
+                    const int p = penalties.at(u, v);
+                    cost += d;
+                    if (static_cast<long long>(d) * (1 + max_p) >
+                        static_cast<long long>(max_d) * (1 + p)) {
+                        max_d = d;
+                        max_p = p;
+                    }
+                }
+
+                best_cost = std::min(best_cost, cost);
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return best_cost;
+                }
+
+                if (lambda == 0) {
+                    lambda = std::max(1, static_cast<int>(
+                                             std::lround(penalty_factor * cost / size)));
+                }
+
+                // penalize every edge of maximum utility
+                penalized.clear();
+                for (size_t i = 0, u = 0; i < size; ++i, u = tour.next(u)) {
+                    const size_t v = tour.next(u);
+                    const int d = distance_matrix.at(u, v);
+                    const int p = penalties.at(u, v);
+                    if (static_cast<long long>(d) * (1 + max_p) ==
+                        static_cast<long long>(max_d) * (1 + p)) {
+                        penalties.increment(u, v);
+                        penalized.push_back(u);
+                        penalized.push_back(v);
+                    }
+                }
+
+                improvement::optimize_tour(stage, two_opt, or_opt, tour, &penalized);
+            }
+        };
+
+        if (size >= improvement::two_level_list_min_size) {
+            TwoLevelList tour(size);
+            return search(tour);
+        }
+
+        ArrayTour tour(size);
+        return search(tour);
+    };
+
+    const auto executor(executor::parallel_executor(std::move(n_workers_opt), std::move(worker)));
+
+    return executor.get_best_result(utils::min_element);
+}
@@ -0,0 +1,33 @@
+#include <chrono>    // std::chrono
+#include <iostream>  // std::cout, std::endl
+#include <optional>  // std::optional
+
+#include "DistanceMatrix.h"
+#include "guided_local_search_tsp.h"
+#include "read_file.h"
+#include "shared_utils.h"
+
+int main(int argc, char** argv) {
+    // time limit in seconds, which must be a positive number
+    const std::optional<double> seconds = argc == 3 ? utils::parse_seconds(argv[2]) : 1.0;
+
+    if ((argc != 2 && argc != 3) || !seconds.has_value()) {
+        std::cerr << "1 argument required: filename. Optional argument: time limit in seconds"
+                  << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+    auto distance_matrix = point_reader->create_distance_matrix();
+
+    // every CPU core runs its own search until the time limit expires
+    const auto time_limit =
+        std::chrono::milliseconds(static_cast<long long>(seconds.value() * 1000));
+
+    // calculate the weight of TSP with Guided Local Search
+    const int total_weight = guided_local_search_tsp(distance_matrix, time_limit);
+
+    // use std::fixed to avoid displaying numbers in scientific notation
+    std::cout << std::fixed << total_weight << std::endl;
+}
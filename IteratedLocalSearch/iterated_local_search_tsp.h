@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <chrono>     // std::chrono
+#include <optional>   // std::optional
+#include <vector>     // std::vector
+
+#include "ArrayTour.h"
+#include "DistanceMatrix.h"
+#include "TwoLevelList.h"
+#include "UndoableTour.h"
+#include "double_bridge.h"
+#include "greedy_edge.h"
+#include "improvement.h"
+#include "nearest_neighbors.h"
+#include "or_opt.h"
+#include "parallel_executor.h"
+#include "random_generator.h"
+#include "shared_utils.h"
+#include "two_opt.h"
+
+// maximum number of vertexes of the segments swapped by the double bridge kick
+constexpr size_t max_kick_segment_length = 50;
+
+/**
+ * Iterated Local Search for the Metric-TSP, starting from the Greedy Edge circuit improved by
+ * 2-opt and Or-opt on the k nearest neighbors of every node. Then every CPU core repeats
+ * iterations on its own copy of the circuit until time_limit expires: an iteration applies a
+ * local double bridge kick, which swaps 2 random consecutive segments of at most
+ * max_kick_segment_length nodes, and runs 2-opt and Or-opt again starting from the 6 endpoints
+ * of the kick only. The iteration is kept if the circuit didn't get worse, otherwise its changes
+ * are undone.
+ * Since the kick, the local search and its undo only touch the circuit around the kick, an
+ * iteration doesn't depend on n but for the length of the paths reversed by the moves.
+ * Return the weight of the best circuit found.
+ * Time: O(n^2 log k) for the neighbor lists, plus the iterations.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param time_limit every worker stops starting new iterations after this time.
+ * @param k number of nearest neighbors of each node considered by the local search.
+ * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core is
+ *                      used.
+ */
+[[nodiscard]] inline int iterated_local_search_tsp(const DistanceMatrix<int>& distance_matrix,
+                                                   const std::chrono::milliseconds time_limit,
+                                                   const size_t k = improvement::n_neighbors,
+                                                   std::optional<size_t>&& n_workers_opt = {}) {
+    constexpr auto stage = improvement::Stage::two_opt_or_opt;
+
+    const size_t size = distance_matrix.size();
+    const auto deadline = std::chrono::steady_clock::now() + time_limit;
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const std::vector<size_t> greedy_circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    const int greedy_cost =
+        utils::sum_weights_as_circuit(greedy_circuit.cbegin(), greedy_circuit.cend(), get_distance);
+
+    // every move needs 2 edges that don't share a node
+    if (size < 4) {
+        return greedy_cost;
+    }
+
+    const auto neighbors = neighbors::k_nearest_neighbors(distance_matrix, k);
+
+    // the 2 segments of the kick and its 2 other endpoints must be distinct
+    const size_t max_length = std::max<size_t>(std::min(max_kick_segment_length, size / 2 - 1), 1);
+
+    auto worker = [&]() {
+        local_search::TwoOpt two_opt(get_distance, neighbors);
+        local_search::OrOpt or_opt(get_distance, neighbors);
+        random_generator::IntegerRandomGenerator rand_vertex(0, size - 1);
+        random_generator::IntegerRandomGenerator rand_length(1, max_length);
+
+        // run the search on tour, and return the weight of the circuit found
+        const auto search = [&](auto& tour) {
+            tour.assign(greedy_circuit);
+            int cost = greedy_cost - improvement::optimize_tour(stage, two_opt, or_opt, tour);
+
+            UndoableTour undoable_tour(tour);
+
+            // the double bridge kick needs 8 distinct nodes
+            while (size >= 8 && std::chrono::steady_clock::now() < deadline) {
+                const auto kick = local_search::double_bridge_t::after(
+                    undoable_tour, rand_vertex(), rand_length(), rand_length());
+                kick.apply([&undoable_tour](const size_t a, const size_t b, const size_t c,
+                                            const size_t d) {
+                    undoable_tour.exchange(a, b, c, d);
+                });
+
+                const auto endpoints = kick.endpoints();
+                const int gain = kick.gain(get_distance) +
+                                 improvement::optimize_tour(stage, two_opt, or_opt,
+                                                            undoable_tour, &endpoints);
+
+                if (gain >= 0) {
+                    cost -= gain;
+                    undoable_tour.commit();
+                } else {
+                    undoable_tour.undo();
+                }
+            }
+
+            return cost;
+        };
+
+        if (size >= improvement::two_level_list_min_size) {
+            TwoLevelList tour(size);
+            return search(tour);
+        }
+
+        ArrayTour tour(size);
+        return search(tour);
+    };
+
+    const auto executor(executor::parallel_executor(std::move(n_workers_opt), std::move(worker)));
+
+    return executor.get_best_result(utils::min_element);
+}
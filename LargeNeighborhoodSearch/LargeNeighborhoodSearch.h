@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <cmath>      // std::exp
+#include <limits>     // std::numeric_limits
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "LinkedTour.h"
+#include "insertion_policies.h"
+#include "random_generator.h"
+
+namespace lns {
+    // ways to select the cities removed from the tour
+    enum class Destroy { segment, random_subset, cluster };
+
+    // ways to insert the removed cities back into the tour
+    enum class Repair { cheapest, regret };
+
+    /**
+     * Large Neighborhood Search for the Metric-TSP. Every step removes q cities from the current
+     * tour (destroy), inserts them back (repair) and keeps the new tour according to the
+     * Metropolis criterion, otherwise it restores the previous one.
+     * The tour is a LinkedTour, and a removed city is only inserted next to one of its nearest
+     * neighbors that are still in the tour, so both destroy and repair take time proportional to
+     * q instead of n: O(q) to destroy, O(q^2 k) to repair with k nearest neighbors and O(q) to
+     * undo a rejected step.
+     */
+    class LargeNeighborhoodSearch {
+        // index value used to mark missing insertion points
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        const DistanceMatrix<int>& distance_matrix;
+
+        // neighbors[v] are the nearest neighbors of v, sorted by distance
+        const std::vector<std::vector<size_t>>& neighbors;
+
+        LinkedTour tour;
+
+        // weight of tour
+        int cost = 0;
+
+        // cities removed by the last destroy step, in order of removal, and their predecessors
+        // at the time of removal, used to undo the step
+        std::vector<size_t> removed;
+        std::vector<size_t> removed_prev;
+
+        // removed cities not yet inserted back by the repair step
+        std::vector<size_t> pending;
+
+        // real number generator in the range [0, 1)
+        random_generator::RealRandomGenerator random{0.0, 1.0};
+
+        // best insertion point of a removed city among the candidate arcs
+        struct insertion_point {
+            // the city is inserted in between i and tour.next(i)
+            size_t i = npos;
+            long long best_cost = std::numeric_limits<long long>::max();
+            long long second_cost = std::numeric_limits<long long>::max();
+        };
+
+        // return a random integer in [0, n)
+        [[nodiscard]] size_t random_index(const size_t n) {
+            return std::min(static_cast<size_t>(random() * n), n - 1);
+        }
+
+        void remove(const size_t v) noexcept {
+            const size_t prev = tour.prev(v);
+            cost -= insertion::detail::insertion_cost(distance_matrix, prev, v, tour.next(v));
+            removed.push_back(v);
+            removed_prev.push_back(prev);
+            tour.erase(v);
+        }
+
+        // remove q consecutive cities, starting from a random one
+        void destroy_segment(const size_t q) {
+            size_t v = random_index(distance_matrix.size());
+            for (size_t count = 0; count < q; ++count) {
+                const size_t next = tour.next(v);
+                remove(v);
+                v = next;
+            }
+        }
+
+        // remove q random cities
+        void destroy_random_subset(const size_t q) {
+            const size_t size = distance_matrix.size();
+            while (removed.size() < q) {
+                const size_t v = random_index(size);
+                if (tour.contains(v)) {
+                    remove(v);
+                }
+            }
+        }
+
+        // remove a random city and the q - 1 cities closest to it, visiting the nearest neighbor
+        // lists breadth-first
+        void destroy_cluster(const size_t q) {
+            remove(random_index(distance_matrix.size()));
+            for (size_t index = 0; index < removed.size() && removed.size() < q; ++index) {
+                for (const size_t c : neighbors[removed[index]]) {
+                    if (removed.size() == q) {
+                        break;
+                    }
+                    if (tour.contains(c)) {
+                        remove(c);
+                    }
+                }
+            }
+        }
+
+        // find the 2 cheapest arcs where u can be inserted among the arcs adjacent to the
+        // nearest neighbors of u in the tour
+        // Time: O(k)
+        [[nodiscard]] insertion_point find_insertion_point(const size_t u) const noexcept {
+            insertion_point point;
+
+            const auto consider = [&](const size_t i) {
+                const long long insertion_cost =
+                    insertion::detail::insertion_cost(distance_matrix, i, u, tour.next(i));
+
+                if (insertion_cost < point.best_cost) {
+                    point.second_cost = point.best_cost;
+                    point.best_cost = insertion_cost;
+                    point.i = i;
+                } else if (insertion_cost < point.second_cost && i != point.i) {
+                    point.second_cost = insertion_cost;
+                }
+            };
+
+            for (const size_t c : neighbors[u]) {
+                if (tour.contains(c)) {
+                    consider(c);
+                    consider(tour.prev(c));
+                }
+            }
+
+            return point;
+        }
+
+        // insert the pending cities back into the tour. Cheapest repair inserts the city with the
+        // cheapest insertion first, Regret repair inserts first the city that would lose the most
+        // if it weren't inserted at its best arc.
+        // Time: O(q^2 k)
+        void repair(const Repair policy) {
+            pending = removed;
+
+            while (!pending.empty()) {
+                size_t selected = npos;
+                insertion_point selected_point;
+                long long selected_priority = std::numeric_limits<long long>::min();
+
+                for (size_t index = 0; index < pending.size(); ++index) {
+                    const insertion_point point = find_insertion_point(pending[index]);
+                    if (point.i == npos) {
+                        continue;
+                    }
+
+                    const long long priority = policy == Repair::cheapest
+                                                   ? -point.best_cost
+                                                   : point.second_cost - point.best_cost;
+
+                    if (priority > selected_priority) {
+                        selected_priority = priority;
+                        selected_point = point;
+                        selected = index;
+                    }
+                }
+
+                // none of the nearest neighbors of the pending cities is in the tour, so the
+                // insertion point of the first one is searched among all the arcs
+                if (selected == npos) {
+                    selected = 0;
+                    const auto [i, insertion_cost] =
+                        insertion::detail::best_insertion(distance_matrix, pending[0], tour);
+                    selected_point.i = i;
+                    selected_point.best_cost = insertion_cost;
+                }
+
+                cost += static_cast<int>(selected_point.best_cost);
+                tour.insert_after(selected_point.i, pending[selected]);
+
+                pending[selected] = pending.back();
+                pending.pop_back();
+            }
+        }
+
+        // restore the tour as it was before the last destroy step
+        // Time: O(q)
+        void undo(const int old_cost) noexcept {
+            for (const size_t v : removed) {
+                tour.erase(v);
+            }
+
+            for (size_t index = removed.size(); index-- > 0;) {
+                tour.insert_after(removed_prev[index], removed[index]);
+            }
+
+            cost = old_cost;
+        }
+
+    public:
+        /**
+         * @param distance_matrix represents the graph as a Distance Matrix.
+         * @param neighbors nearest neighbors of every city, sorted by distance. See
+         *                  neighbors::k_nearest_neighbors.
+         * @param circuit initial Hamiltonian circuit.
+         * @param cost weight of circuit.
+         */
+        LargeNeighborhoodSearch(const DistanceMatrix<int>& distance_matrix,
+                                const std::vector<std::vector<size_t>>& neighbors,
+                                const std::vector<size_t>& circuit, const int cost) :
+            distance_matrix(distance_matrix),
+            neighbors(neighbors),
+            tour(distance_matrix.size(), circuit),
+            cost(cost) {
+        }
+
+        // return the weight of the current tour
+        [[nodiscard]] int get_cost() const noexcept {
+            return cost;
+        }
+
+        // return the current tour
+        [[nodiscard]] const LinkedTour& get_tour() const noexcept {
+            return tour;
+        }
+
+        /**
+         * Destroy and repair the tour once, removing between 1 and max_removed cities, with a
+         * random destroy and repair policy. The new tour is accepted with the Metropolis
+         * criterion at the given temperature. Return true iff the new tour has been accepted.
+         */
+        bool step(const size_t max_removed, const double temperature) {
+            const size_t q = 1 + random_index(max_removed);
+            const int old_cost = cost;
+
+            removed.clear();
+            removed_prev.clear();
+
+            switch (static_cast<Destroy>(random_index(3))) {
+                case Destroy::segment:
+                    destroy_segment(q);
+                    break;
+                case Destroy::random_subset:
+                    destroy_random_subset(q);
+                    break;
+                case Destroy::cluster:
+                    destroy_cluster(q);
+                    break;
+            }
+
+            repair(random() < 0.5 ? Repair::cheapest : Repair::regret);
+
+            const int delta = cost - old_cost;
+            if (delta <= 0 || random() < std::exp(-delta / temperature)) {
+                return true;
+            }
+
+            undo(old_cost);
+            return false;
+        }
+    };
+}  // namespace lns
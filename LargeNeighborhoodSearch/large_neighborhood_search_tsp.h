@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>  // std::clamp, std::min
+#include <chrono>     // std::chrono
+#include <cmath>      // std::pow
+#include <optional>   // std::optional
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "LargeNeighborhoodSearch.h"
+#include "greedy_edge.h"
+#include "nearest_neighbors.h"
+#include "parallel_executor.h"
+#include "shared_utils.h"
+
+/**
+ * Large Neighborhood Search for the Metric-TSP, starting from the Greedy Edge circuit.
+ * Every CPU core runs its own search until time_limit expires, with a temperature that decreases
+ * geometrically with the elapsed time, from a fraction of the average edge weight to 1/100 of it.
+ * Return the weight of the best circuit found.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param time_limit duration of the search.
+ * @param k number of nearest neighbors of each city considered by destroy and repair.
+ * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core is
+ *                      used.
+ */
+[[nodiscard]] inline int large_neighborhood_search_tsp(
+    const DistanceMatrix<int>& distance_matrix, const std::chrono::milliseconds time_limit,
+    const size_t k = 10, std::optional<size_t>&& n_workers_opt = {}) {
+    using clock = std::chrono::steady_clock;
+
+    const size_t size = distance_matrix.size();
+
+    const auto get_distance = [&](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const std::vector<size_t> greedy_circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    const int greedy_cost =
+        utils::sum_weights_as_circuit(greedy_circuit.cbegin(), greedy_circuit.cend(), get_distance);
+
+    // destroy and repair need at least 3 cities left in the tour
+    if (size < 5) {
+        return greedy_cost;
+    }
+
+    const auto neighbors = neighbors::k_nearest_neighbors(distance_matrix, k);
+
+    // maximum number of cities removed by every destroy step
+    const size_t max_removed = std::clamp<size_t>(size / 10, 2, 50);
+
+    // temperatures at the beginning and at the end of the search
+    const double init_temperature = 0.3 * greedy_cost / size;
+    const double final_temperature = init_temperature / 100;
+
+    auto worker = [&]() {
+        const auto start = clock::now();
+        const auto deadline = start + time_limit;
+        const double total_time = std::chrono::duration<double>(time_limit).count();
+
+        lns::LargeNeighborhoodSearch search(distance_matrix, neighbors, greedy_circuit,
+                                            greedy_cost);
+        int best_cost = greedy_cost;
+
+        for (auto now = start; now < deadline; now = clock::now()) {
+            const double progress = std::chrono::duration<double>(now - start).count() / total_time;
+            const double temperature =
+                init_temperature * std::pow(final_temperature / init_temperature, progress);
+
+            search.step(max_removed, temperature);
+            best_cost = std::min(best_cost, search.get_cost());
+        }
+
+        return best_cost;
+    };
+
+    const auto executor(executor::parallel_executor(std::move(n_workers_opt), std::move(worker)));
+
+    return executor.get_best_result(utils::min_element);
+}
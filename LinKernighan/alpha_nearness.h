@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min, std::partial_sort
+#include <climits>    // INT_MIN
+#include <numeric>    // std::iota
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "nearest_neighbors.h"
+#include "prim_binary_heap_mst.h"
+
+namespace alpha_nearness {
+    /**
+     * A minimum 1-tree is a minimum spanning tree on every node but a special node s, plus the 2
+     * shortest edges incident to s. Since every tour is a 1-tree, its weight is a lower bound of
+     * the optimal tour.
+     * If s is a leaf of the minimum spanning tree of the whole graph, its tree edge is the
+     * shortest edge incident to s and the rest of the tree spans the other nodes, so a minimum
+     * 1-tree is that spanning tree plus the second shortest edge of s. s is chosen among the
+     * leaves so that the added edge is as long as possible, which maximizes the lower bound.
+     */
+    struct one_tree {
+        // adjacent[v] are the pairs (u, w(u, v)) of the tree edges incident to v, where the
+        // edges incident to special are not included
+        std::vector<std::vector<std::pair<size_t, int>>> adjacent;
+
+        // the special node and its 2 neighbors in the 1-tree
+        size_t special;
+        size_t first_neighbor;
+        size_t second_neighbor;
+
+        // weight of the longest edge incident to special
+        int special_max_weight;
+    };
+
+    /**
+     * Return a minimum 1-tree of the graph, built on the minimum spanning tree computed by Prim's
+     * algorithm. The graph must have at least 3 nodes.
+     * Time: O(n^2 log n), dominated by Prim's algorithm.
+     */
+    [[nodiscard]] inline one_tree minimum_one_tree(const DistanceMatrix<int>& distance_matrix) {
+        const size_t size = distance_matrix.size();
+        const auto mst = mst::prim_binary_heap_mst(distance_matrix);
+
+        std::vector<size_t> degree(size, 0);
+        for (const auto& edge : mst) {
+            ++degree[edge.from];
+            ++degree[edge.to];
+        }
+
+        // pick the leaf whose second shortest edge is the longest one
+        one_tree tree{std::vector<std::vector<std::pair<size_t, int>>>(size), 0, 0, 0, INT_MIN};
+        for (const auto& edge : mst) {
+            for (const auto& [leaf, other] : {std::pair(edge.from, edge.to),
+                                              std::pair(edge.to, edge.from)}) {
+                if (degree[leaf] != 1) {
+                    continue;
+                }
+
+                size_t second = leaf;
+                for (size_t v = 0; v < size; ++v) {
+                    if (v != leaf && v != other &&
+                        (second == leaf ||
+                         distance_matrix.at(leaf, v) < distance_matrix.at(leaf, second))) {
+                        second = v;
+                    }
+                }
+
+                const int max_weight = std::max(edge.weight, distance_matrix.at(leaf, second));
+                if (max_weight > tree.special_max_weight) {
+                    tree.special = leaf;
+                    tree.first_neighbor = other;
+                    tree.second_neighbor = second;
+                    tree.special_max_weight = max_weight;
+                }
+            }
+        }
+
+        for (const auto& edge : mst) {
+            if (edge.from != tree.special && edge.to != tree.special) {
+                tree.adjacent[edge.from].emplace_back(edge.to, edge.weight);
+                tree.adjacent[edge.to].emplace_back(edge.from, edge.weight);
+            }
+        }
+
+        return tree;
+    }
+
+    /**
+     * Return the candidate lists of the graph by alpha-nearness: for every node v, the k nodes u
+     * with the smallest alpha(v, u), sorted by alpha and then by distance from v.
+     * alpha(v, u) is the increase of weight of the minimum 1-tree that is forced to contain the
+     * edge (v, u). It's w(v, u) minus the weight of the longest edge on the tree path from v to
+     * u, or minus the longest edge incident to the special node if either v or u is special.
+     * Edges of the optimal tour have small alpha values far more often than they connect near
+     * nodes, so fewer candidates are needed than with neighbors::k_nearest_neighbors.
+     * Time: O(n^2 log k), since the tree is visited from every node.
+     *
+     * @param distance_matrix represents the graph as a Distance Matrix.
+     * @param k number of candidates of each node. It's clamped to n - 1.
+     */
+    [[nodiscard]] inline std::vector<std::vector<size_t>> alpha_nearest_neighbors(
+        const DistanceMatrix<int>& distance_matrix, const size_t k) {
+        const size_t size = distance_matrix.size();
+        if (size < 3) {
+            return neighbors::k_nearest_neighbors(distance_matrix, k);
+        }
+
+        const size_t n_neighbors = std::min(k, size - 1);
+        const one_tree tree = minimum_one_tree(distance_matrix);
+
+        std::vector<std::vector<size_t>> neighbors(size);
+        std::vector<size_t> others(size - 1);
+
+        // alpha[u] is alpha(v, u) for the node v being visited
+        std::vector<int> alpha(size);
+
+        // beta[u] is the weight of the longest edge on the tree path from v to u
+        std::vector<int> beta(size);
+        std::vector<std::pair<size_t, size_t>> stack;
+        stack.reserve(size);
+
+        for (size_t v = 0; v < size; ++v) {
+            if (v == tree.special) {
+                for (size_t u = 0; u < size; ++u) {
+                    alpha[u] = u == tree.first_neighbor || u == tree.second_neighbor
+                                   ? 0
+                                   : distance_matrix.at(v, u) - tree.special_max_weight;
+                }
+            } else {
+                // depth first visit of the tree from v: pairs (node, parent)
+                beta[v] = 0;
+                stack.emplace_back(v, v);
+                while (!stack.empty()) {
+                    const auto [u, parent] = stack.back();
+                    stack.pop_back();
+
+                    for (const auto& [child, weight] : tree.adjacent[u]) {
+                        if (child != parent) {
+                            beta[child] = std::max(beta[u], weight);
+                            stack.emplace_back(child, u);
+                        }
+                    }
+                }
+
+                for (size_t u = 0; u < size; ++u) {
+                    alpha[u] = distance_matrix.at(v, u) - beta[u];
+                }
+
+                const bool is_special_neighbor =
+                    v == tree.first_neighbor || v == tree.second_neighbor;
+                alpha[tree.special] =
+                    is_special_neighbor
+                        ? 0
+                        : distance_matrix.at(v, tree.special) - tree.special_max_weight;
+            }
+
+            // every node but v
+            std::iota(others.begin(), others.begin() + v, 0);
+            std::iota(others.begin() + v, others.end(), v + 1);
+
+            const auto by_alpha = [&distance_matrix, &alpha, v](const size_t x, const size_t y) {
+                if (alpha[x] != alpha[y]) {
+                    return alpha[x] < alpha[y];
+                }
+
+                return distance_matrix.at(v, x) < distance_matrix.at(v, y);
+            };
+
+            std::partial_sort(others.begin(), others.begin() + n_neighbors, others.end(),
+                              by_alpha);
+            neighbors[v].assign(others.cbegin(), others.cbegin() + n_neighbors);
+        }
+
+        return neighbors;
+    }
+}  // namespace alpha_nearness
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>    // std::chrono
+#include <optional>  // std::optional
+#include <vector>    // std::vector
+
+#include "ArrayTour.h"
+#include "DistanceMatrix.h"
+#include "alpha_nearness.h"
+#include "greedy_edge.h"
+#include "lin_kernighan.h"
+#include "parallel_executor.h"
+#include "shared_utils.h"
+
+/**
+ * Chained Lin-Kernighan heuristic for the Metric-TSP, starting from the Greedy Edge circuit.
+ * The circuit is optimized by local_search::LinKernighan on the k alpha-nearest candidates of
+ * every node (see alpha_nearness::alpha_nearest_neighbors), then every CPU core repeats trials
+ * until time_limit expires: a trial kicks the best circuit found by the core with a local
+ * double bridge and optimizes it again, and it's undone unless the circuit didn't get worse.
+ * Return the weight of the best circuit found.
+ * Time: O(n^2 log n) for the candidates, plus the trials.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param time_limit every worker stops starting new trials after this time.
+ * @param k number of alpha-nearest candidates of each node.
+ * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core is
+ *                      used.
+ */
+[[nodiscard]] inline int lin_kernighan_tsp(const DistanceMatrix<int>& distance_matrix,
+                                           const std::chrono::milliseconds time_limit,
+                                           const size_t k = 5,
+                                           std::optional<size_t>&& n_workers_opt = {}) {
+    const size_t size = distance_matrix.size();
+    const auto deadline = std::chrono::steady_clock::now() + time_limit;
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const std::vector<size_t> greedy_circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    const int greedy_cost =
+        utils::sum_weights_as_circuit(greedy_circuit.cbegin(), greedy_circuit.cend(), get_distance);
+
+    // every flip needs 2 edges that don't share a node
+    if (size < 4) {
+        return greedy_cost;
+    }
+
+    const auto candidates = alpha_nearness::alpha_nearest_neighbors(distance_matrix, k);
+
+    auto worker = [&]() {
+        local_search::LinKernighan lin_kernighan(get_distance, candidates);
+        ArrayTour tour(size);
+        tour.assign(greedy_circuit);
+
+        int cost = greedy_cost - lin_kernighan.optimize(tour);
+
+        // the double bridge kick needs 8 distinct nodes
+        while (size >= 8 && std::chrono::steady_clock::now() < deadline) {
+            const int gain = lin_kernighan.trial(tour);
+            if (gain >= 0) {
+                cost -= gain;
+            } else {
+                lin_kernighan.undo_trial(tour);
+            }
+        }
+
+        return cost;
+    };
+
+    const auto executor(executor::parallel_executor(std::move(n_workers_opt), std::move(worker)));
+
+    return executor.get_best_result(utils::min_element);
+}
@@ -1,12 +1,17 @@
 #include <iostream>  // std::cout, std::endl
 
-#include "DistanceMatrix.h"
 #include "approx_tsp.h"
+#include "DistanceMatrix.h"
+#include "improvement.h"
 #include "read_file.h"
 
 int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
     if (argc != 2) {
-        std::cerr << "1 argument required: filename" << std::endl;
+        std::cerr << "1 argument required: filename. Optional flags: " << improvement::flags_usage
+                  << std::endl;
         exit(0);
     }
 
@@ -19,7 +24,8 @@ int main(int argc, char** argv) {
     DistanceMatrix<int>&& distance_matrix = point_reader->create_distance_matrix();
 
     // calculate the weight of the 2-approximate solution, which uses Prim's MST algorithm
-    const auto total_weight = approx_tsp(std::forward<decltype(distance_matrix)>(distance_matrix));
+    const auto total_weight =
+        approx_tsp(std::forward<decltype(distance_matrix)>(distance_matrix), stage);
 
     // use std::fixed to avoid displaying numbers in scientific notation
     std::cout << std::fixed << total_weight << std::endl;
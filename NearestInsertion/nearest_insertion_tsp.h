@@ -0,0 +1,28 @@
+#pragma once
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "multi_start_insertion_tsp.h"
+#include "random_generator.h"
+
+using namespace random_generator;
+
+// Nearest Insertion: start from a random node i and the node j that minimizes δ(i, j), then
+// repeatedly select the node k not in circuit that minimizes δ(k, circuit), and insert it right
+// before or right after its closest node in the circuit.
+[[nodiscard]] inline int nearest_insertion_tsp(DistanceMatrix<int>& distance_matrix,
+                                               RandomGenerator<size_t>& rand_int,
+                                               const improvement::Stage stage) noexcept {
+    return insertion::insertion_tsp<insertion::select_nearest>(
+        distance_matrix, insertion::seed_random_closest(rand_int), stage);
+}
+
+// Multi-start Nearest Insertion: run Nearest Insertion from n_starts distinct start nodes on
+// every CPU core, and return the weight of the best circuit found.
+[[nodiscard]] inline int nearest_insertion_multi_start_tsp(DistanceMatrix<int>& distance_matrix,
+                                                           const size_t n_starts,
+                                                           const improvement::Stage stage) {
+    return insertion::multi_start_insertion_tsp<insertion::select_nearest>(
+        distance_matrix, n_starts, stage);
+}
@@ -0,0 +1,61 @@
+#include <iostream>  // std::cout, std::endl
+#include <optional>  // std::optional
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "random_generator.h"
+#include "random_insertion_tsp.h"
+#include "read_file.h"
+#include "sequential_executor.h"
+#include "shared_utils.h"
+
+int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
+    // number of distinct start nodes, which must be a positive integer
+    const std::optional<size_t> n_starts_opt =
+        argc == 3 ? utils::parse_count(argv[2]) : std::optional<size_t>(1);
+
+    if ((argc != 2 && argc != 3) || !n_starts_opt.has_value()) {
+        std::cerr << "1 argument required: filename. Optional argument: number of start nodes. "
+                  << "Optional flags: " << improvement::flags_usage << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+    auto distance_matrix = point_reader->create_distance_matrix();
+
+    // number of distinct start nodes, clamped to the number of nodes in the graph
+    const size_t n_starts = n_starts_opt.value();
+
+    if (n_starts > 1) {
+        // run Random Insertion from n_starts distinct start nodes on every CPU core
+        const int total_weight =
+            random_insertion_multi_start_tsp(distance_matrix, n_starts, stage);
+
+        // use std::fixed to avoid displaying numbers in scientific notation
+        std::cout << std::fixed << total_weight << std::endl;
+        return 0;
+    }
+
+    // Generate a random source node for the Hamiltonian cycle found with the Random Insertion
+    // heuristic. If you'd rather started from a fixed node (e.g. 0), just substitute the following
+    // line with `random_generator::FixedGenerator<size_t> rand_int(0);`.
+    random_generator::IntegerRandomGenerator rand_int(0, distance_matrix.size() - 1);
+
+    // calculate the weight of TSP with Random Insertion heuristic
+    auto solve_tsp = [&]() {
+        return random_insertion_tsp(distance_matrix, rand_int, stage);
+    };
+
+    // run Random Insertion only once
+    const auto executor(executor::sequential_executor(1, std::move(solve_tsp)));
+
+    // save the best cost found
+    const int total_weight = executor.get_best_result(utils::min_element);
+
+    // use std::fixed to avoid displaying numbers in scientific notation
+    std::cout << std::fixed << total_weight << std::endl;
+}
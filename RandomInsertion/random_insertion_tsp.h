@@ -0,0 +1,28 @@
+#pragma once
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "multi_start_insertion_tsp.h"
+#include "random_generator.h"
+
+using namespace random_generator;
+
+// Random Insertion: start from a random node i and the node j that minimizes δ(i, j), then
+// repeatedly insert a random node k not in circuit in between the two consecutive tour cities for
+// which such an insertion causes the minimum increase in total tour length.
+[[nodiscard]] inline int random_insertion_tsp(DistanceMatrix<int>& distance_matrix,
+                                              RandomGenerator<size_t>& rand_int,
+                                              const improvement::Stage stage) noexcept {
+    return insertion::insertion_tsp<insertion::select_random>(
+        distance_matrix, insertion::seed_random_closest(rand_int), stage);
+}
+
+// Multi-start Random Insertion: run Random Insertion from n_starts distinct start nodes on every
+// CPU core, and return the weight of the best circuit found.
+[[nodiscard]] inline int random_insertion_multi_start_tsp(DistanceMatrix<int>& distance_matrix,
+                                                          const size_t n_starts,
+                                                          const improvement::Stage stage) {
+    return insertion::multi_start_insertion_tsp<insertion::select_random>(
+        distance_matrix, n_starts, stage);
+}
@@ -0,0 +1,27 @@
+#include <iostream>  // std::cout, std::endl
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "read_file.h"
+#include "savings_tsp.h"
+
+int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
+    if (argc != 2) {
+        std::cerr << "1 argument required: filename. Optional flags: " << improvement::flags_usage
+                  << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+    auto distance_matrix = point_reader->create_distance_matrix();
+
+    // calculate the weight of TSP with the Clarke-Wright Savings heuristic
+    const int total_weight = savings_tsp(distance_matrix, stage);
+
+    // use std::fixed to avoid displaying numbers in scientific notation
+    std::cout << std::fixed << total_weight << std::endl;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>  // std::find, std::find_if, std::sort
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "PathFragments.h"
+#include "improvement.h"
+#include "nearest_neighbors.h"
+
+namespace detail {
+    // the hub is the node that minimizes the sum of its distances to every other node
+    // Time: O(n^2)
+    [[nodiscard]] inline size_t select_hub(const DistanceMatrix<int>& distance_matrix) {
+        const size_t size = distance_matrix.size();
+
+        size_t hub = 0;
+        long long min_sum = -1;
+        for (size_t v = 0; v < size; ++v) {
+            long long sum = 0;
+            for (size_t u = 0; u < size; ++u) {
+                sum += distance_matrix.at(v, u);
+            }
+
+            if (min_sum < 0 || sum < min_sum) {
+                min_sum = sum;
+                hub = v;
+            }
+        }
+
+        return hub;
+    }
+}  // namespace detail
+
+/**
+ * Clarke-Wright Savings heuristic for the Metric-TSP.
+ * Every node is initially visited by its own round trip from a hub node h. Joining the trips of
+ * i and j through the edge (i, j) saves s(i, j) = w(h, i) + w(h, j) - w(i, j), so the edges are
+ * added to the tour in decreasing order of savings, as long as the fragments they join remain
+ * simple paths. At last, the 2 endpoints of the only path left are connected to the hub.
+ * Savings are only computed for the pairs (i, j) where j is one of the k nodes closest to i, so
+ * there are O(nk) candidate edges instead of O(n^2). The fragments that can't be joined by the
+ * candidate edges are joined considering the savings among their endpoints.
+ * Time: O(n^2 log k) to compute the candidates from the distance matrix, plus
+ *       O(nk log(nk)) for the savings, plus O(f^2 log f) to join the f fragment endpoints left.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param stage optional improvement stage applied to the circuit built.
+ * @param k number of nearest neighbors of each node considered as savings candidates.
+ */
+[[nodiscard]] inline int savings_tsp(const DistanceMatrix<int>& distance_matrix,
+                                     const improvement::Stage stage, const size_t k = 10) {
+    const size_t size = distance_matrix.size();
+    if (size < 2) {
+        return 0;
+    }
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const size_t hub = detail::select_hub(distance_matrix);
+
+    // lambda function that returns the savings of the edge (i, j)
+    const auto get_saving = [&](const size_t i, const size_t j) {
+        return get_distance(hub, i) + get_distance(hub, j) - get_distance(i, j);
+    };
+
+    // Step 1: compute the savings of the candidate edges (i, j), with i < j
+    struct saving {
+        int value;
+        size_t i;
+        size_t j;
+    };
+
+    const auto candidates = neighbors::k_nearest_neighbors(distance_matrix, k);
+    std::vector<saving> savings;
+    savings.reserve(size * k);
+
+    for (size_t i = 0; i < size; ++i) {
+        for (const size_t j : candidates[i]) {
+            // every pair appears once, even when i and j are candidates of each other
+            const bool is_duplicate = j < i && std::find(candidates[j].cbegin(),
+                                                         candidates[j].cend(),
+                                                         i) != candidates[j].cend();
+
+            if (i != hub && j != hub && !is_duplicate) {
+                savings.push_back({get_saving(i, j), i, j});
+            }
+        }
+    }
+
+    // Step 2: add the edges in decreasing order of savings
+    std::sort(savings.begin(), savings.end(), [](const auto& a, const auto& b) {
+        return a.value > b.value;
+    });
+
+    PathFragments fragments(size);
+    for (const auto& [_, i, j] : savings) {
+        fragments.link(i, j);
+    }
+
+    // Step 3: join the fragments left, considering every pair of their endpoints
+    std::vector<size_t> endpoints;
+    for (size_t v = 0; v < size; ++v) {
+        if (v != hub && fragments.is_endpoint(v)) {
+            endpoints.push_back(v);
+        }
+    }
+
+    fragments.join(endpoints, get_saving);
+
+    // Step 4: connect the endpoints of the only path left to the hub
+    const size_t first = *std::find_if(endpoints.cbegin(), endpoints.cend(), [&](const size_t v) {
+        return fragments.is_endpoint(v);
+    });
+
+    std::vector<size_t> circuit{hub};
+    const std::vector<size_t> path(fragments.path_from(first));
+    circuit.insert(circuit.end(), path.cbegin(), path.cend());
+
+    return improvement::improve_circuit(stage, distance_matrix, circuit);
+}
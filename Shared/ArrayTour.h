@@ -0,0 +1,120 @@
+#pragma once
+
+#include <utility>  // std::swap
+#include <vector>   // std::vector
+
+/**
+ * ArrayTour represents a Hamiltonian circuit over the vertexes in [0, capacity) as the array of
+ * the vertexes in tour order, together with the position of every vertex in that array.
+ * Successor, predecessor and betweenness queries take O(1), and reversing a path takes time
+ * linear in the length of the shorter side of the circuit, which is what the 2-opt move needs.
+ * The orientation of the circuit is not preserved by reverse.
+ */
+class ArrayTour {
+    // order[i] is the i-th vertex of the tour
+    std::vector<size_t> order;
+
+    // position[v] is the index of v in order
+    std::vector<size_t> position;
+
+public:
+    explicit ArrayTour(const size_t capacity) : order(capacity), position(capacity) {
+    }
+
+    // replace the tour with circuit, which must visit every vertex in [0, capacity) exactly once.
+    // The memory already allocated is reused.
+    // Time: O(n)
+    void assign(const std::vector<size_t>& circuit) noexcept {
+        const size_t size = order.size();
+        for (size_t i = 0; i < size; ++i) {
+            order[i] = circuit[i];
+            position[circuit[i]] = i;
+        }
+    }
+
+    // write the vertexes in tour order to circuit
+    // Time: O(n)
+    void copy_to(std::vector<size_t>& circuit) const {
+        circuit.assign(order.cbegin(), order.cend());
+    }
+
+    // return the number of vertexes in the tour
+    [[nodiscard]] size_t size() const noexcept {
+        return order.size();
+    }
+
+    // return the vertexes in tour order
+    [[nodiscard]] const std::vector<size_t>& nodes() const noexcept {
+        return order;
+    }
+
+    // return the index of v in tour order
+    [[nodiscard]] size_t position_of(const size_t v) const noexcept {
+        return position[v];
+    }
+
+    // return the vertex that follows v in the tour
+    [[nodiscard]] size_t next(const size_t v) const noexcept {
+        const size_t i = position[v] + 1;
+        return order[i == order.size() ? 0 : i];
+    }
+
+    // return the vertex that precedes v in the tour
+    [[nodiscard]] size_t prev(const size_t v) const noexcept {
+        const size_t i = position[v];
+        return order[i == 0 ? order.size() - 1 : i - 1];
+    }
+
+    // return true iff b is met while going forward from a to c, a and c included
+    [[nodiscard]] bool between(const size_t a, const size_t b, const size_t c) const noexcept {
+        const size_t i = position[a];
+        const size_t j = position[b];
+        const size_t k = position[c];
+
+        return i <= k ? i <= j && j <= k : i <= j || j <= k;
+    }
+
+    /**
+     * Reverse the path that goes forward from a to b. If the path is longer than half the tour,
+     * its complement is reversed instead, which yields the same circuit traversed the other way.
+     * Time: O(min(m, n - m)), where m is the length of the path.
+     */
+    void reverse(const size_t a, const size_t b) noexcept {
+        const size_t size = order.size();
+        size_t i = position[a];
+        size_t j = position[b];
+        size_t length = (j + size - i) % size + 1;
+
+        if (2 * length > size) {
+            const size_t complement_i = j + 1 == size ? 0 : j + 1;
+            j = i == 0 ? size - 1 : i - 1;
+            i = complement_i;
+            length = size - length;
+        }
+
+        for (size_t step = 0; step < length / 2; ++step) {
+            std::swap(order[i], order[j]);
+            position[order[i]] = i;
+            position[order[j]] = j;
+
+            i = i + 1 == size ? 0 : i + 1;
+            j = j == 0 ? size - 1 : j - 1;
+        }
+    }
+
+    /**
+     * Replace the tour edges (a, b) and (c, d) with (a, c) and (b, d), where a, b, c and d are
+     * met in this order along one of the 2 directions of the tour. Since reverse may flip the
+     * direction of the tour, moves made of several reversals are expressed as a sequence of
+     * these edge exchanges.
+     * Time: same as reverse.
+     */
+    void exchange(const size_t a, const size_t b, const size_t c,
+                  [[maybe_unused]] const size_t d) noexcept {
+        if (next(a) == b) {
+            reverse(b, c);
+        } else {
+            reverse(c, b);
+        }
+    }
+};
@@ -92,6 +92,11 @@ public:
         return data.at(get_index(i, j));
     }
 
+    // return a pointer to the values of row i, which are stored contiguously
+    [[nodiscard]] const T* row(size_t i) const noexcept {
+        return data.data() + get_index(i, 0);
+    }
+
     // return the vertexes in the distance matrix
     [[nodiscard]] std::vector<size_t> get_vertexes() const noexcept {
         std::vector<size_t> v(n_vertexes);
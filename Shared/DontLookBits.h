@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>  // std::vector
+
+/**
+ * DontLookBits keeps the vertexes that a local search still has to scan, in FIFO order.
+ * A vertex whose don't-look bit is set isn't in the queue: it leaves the queue when no improving
+ * move starts from it, and it's pushed again when one of its tour edges changes.
+ * Every vertex is in the queue at most once, so the queue is a circular buffer of capacity n and
+ * push and pop never allocate memory.
+ */
+class DontLookBits {
+    // circular FIFO queue of the vertexes whose don't-look bit is not set
+    std::vector<size_t> queue;
+    size_t head = 0;
+    size_t n_queued = 0;
+
+    // queued[v] is true iff v is in queue
+    std::vector<bool> queued;
+
+public:
+    // create an empty queue that can store the vertexes in [0, capacity)
+    explicit DontLookBits(const size_t capacity) : queue(capacity), queued(capacity, false) {
+    }
+
+    // return true iff every don't-look bit is set
+    [[nodiscard]] bool empty() const noexcept {
+        return n_queued == 0;
+    }
+
+    // clear the don't-look bit of v, unless it's already clear
+    void push(const size_t v) noexcept {
+        if (queued[v]) {
+            return;
+        }
+
+        const size_t tail = head + n_queued;
+        queue[tail < queue.size() ? tail : tail - queue.size()] = v;
+        ++n_queued;
+        queued[v] = true;
+    }
+
+    // set the don't-look bit of the oldest vertex in the queue, and return it
+    [[nodiscard]] size_t pop() noexcept {
+        const size_t v = queue[head];
+        head = head + 1 == queue.size() ? 0 : head + 1;
+        --n_queued;
+        queued[v] = false;
+        return v;
+    }
+
+    // clear the don't-look bits of the given vertexes, and set every other bit
+    template <class Vertexes>
+    void reset(const Vertexes& vertexes) noexcept {
+        while (!empty()) {
+            (void)pop();
+        }
+
+        for (const size_t v : vertexes) {
+            push(v);
+        }
+    }
+
+    // clear the don't-look bits of every vertex of tour, in tour order
+    template <class Tour>
+    void reset_tour(const Tour& tour) noexcept {
+        while (!empty()) {
+            (void)pop();
+        }
+
+        size_t v = 0;
+        for (size_t i = 0; i < tour.size(); ++i) {
+            push(v);
+            v = tour.next(v);
+        }
+    }
+};
@@ -30,6 +30,16 @@ namespace point_reader {
             detail::read_point(this->file, this->dimension, point_vec);
         }
 
+        // return the points read from the input file, indexed by their vertex label
+        [[nodiscard]] const std::vector<point_t>& points() const noexcept {
+            return point_vec;
+        }
+
+        // EUC_2D points already lie on the plane
+        [[nodiscard]] std::vector<point_t> planar_points() const override {
+            return point_vec;
+        }
+
         // calculate the distance between the i-th and the j-th points
         [[nodiscard]] int distance(size_t i, size_t j) const override {
             return distance::euclidean_distance(point_vec[i], point_vec[j]);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>    // std::cos
 #include <fstream>  // std::fstream
 #include <vector>   // std::vector
 
@@ -34,6 +35,28 @@ namespace point_reader {
         [[nodiscard]] int distance(size_t i, size_t j) const override {
             return distance::geodesic_distance(point_vec[i], point_vec[j]);
         }
+
+        // project the geographic coordinates to the plane with an equirectangular projection
+        // centered in the mean latitude of the points, so that planar distances are in km
+        [[nodiscard]] std::vector<point::point_2D> planar_points() const override {
+            // radius of earth in km, as in distance::geodesic_distance
+            constexpr double RRR = 6378.388;
+
+            double mean_latitude = 0;
+            for (const auto& p : point_vec) {
+                mean_latitude += p.latitude / point_vec.size();
+            }
+
+            const double cos_latitude = std::cos(mean_latitude);
+
+            std::vector<point::point_2D> points;
+            points.reserve(point_vec.size());
+            for (const auto& [latitude, longitude] : point_vec) {
+                points.emplace_back(RRR * longitude * cos_latitude, RRR * latitude);
+            }
+
+            return points;
+        }
     };
 
 }  // namespace point_reader
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cassert>     // std::assert
+#include <functional>  // std::less, std::greater
+#include <limits>      // std::numeric_limits
+#include <utility>     // std::swap, std::pair
+#include <vector>      // std::vector
+
+namespace priority_queue {
+    /**
+     * Indexed Priority Queue based on a Binary Heap, specialized for elements that are vertexes
+     * labelled in [0, capacity). It follows the same ideas of the PriorityQueue used by Prim's
+     * algorithm, but the key map and the index map are replaced by flat vectors indexed by the
+     * element itself, and the comparator is resolved at compile time. This avoids any hashing
+     * in the hot loops of the insertion heuristics.
+     * This class shouldn't be invoked directly.
+     * Instead, the factories make_min_indexed_priority_queue and make_max_indexed_priority_queue
+     * should be used.
+     *
+     * Key: type of the keys used to order the Heap.
+     * Compare: comp(a, b) is true iff the key a has higher priority than the key b.
+     *          std::less<> -> Min Heap
+     *          std::greater<> -> Max Heap
+     */
+    template <typename Key, typename Compare>
+    class IndexedPriorityQueue {
+        // index value used to mark elements that aren't in the priority queue
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        // elements stored in the heap
+        std::vector<size_t> nodes;
+
+        // keys[element] -> key assigned to element
+        std::vector<Key> keys;
+
+        // index[element] -> index in nodes of element, or npos if element isn't in the heap
+        std::vector<size_t> index;
+
+        Compare comp;
+
+        // return the parent of nodes[i]
+        [[nodiscard]] static size_t parent(const size_t i) noexcept {
+            return (i - 1) >> 1;
+        }
+
+        // returns the left child of nodes[i]
+        [[nodiscard]] static size_t left(const size_t i) noexcept {
+            return (i << 1) + 1;
+        }
+
+        // return true iff nodes[i] should stay above nodes[j]
+        [[nodiscard]] bool has_priority(const size_t i, const size_t j) const noexcept {
+            return comp(keys[nodes[i]], keys[nodes[j]]);
+        }
+
+        // swap 2 nodes in the heap, keeping their indexes up to date
+        void swap_nodes(const size_t i, const size_t j) noexcept {
+            std::swap(nodes[i], nodes[j]);
+            index[nodes[i]] = i;
+            index[nodes[j]] = j;
+        }
+
+        // starting from a Heap with a misplaced node at the given index,
+        // recover the shape and heap properties in O(logN) bubbling the node up.
+        // Return the final index of the node.
+        size_t heapify_up(size_t i) noexcept {
+            while (i > 0 && has_priority(i, parent(i))) {
+                const size_t p = parent(i);
+                swap_nodes(i, p);
+                i = p;
+            }
+
+            return i;
+        }
+
+        // starting from a Heap with a misplaced node at the given index,
+        // recover the shape and heap properties in O(logN) bubbling the node down
+        void heapify_down(size_t i) noexcept {
+            const size_t len = nodes.size();
+
+            while (true) {
+                const size_t l = left(i);
+                const size_t r = l + 1;
+                size_t best = i;
+
+                if (l < len && has_priority(l, best)) {
+                    best = l;
+                }
+                if (r < len && has_priority(r, best)) {
+                    best = r;
+                }
+
+                if (best == i) {
+                    return;
+                }
+
+                swap_nodes(i, best);
+                i = best;
+            }
+        }
+
+        // the node at index i may violate the heap property in either direction
+        void heapify(const size_t i) noexcept {
+            if (heapify_up(i) == i) {
+                heapify_down(i);
+            }
+        }
+
+    public:
+        // create an empty priority queue that can store the elements in [0, capacity)
+        explicit IndexedPriorityQueue(const size_t capacity) :
+            keys(capacity), index(capacity, npos) {
+            nodes.reserve(capacity);
+        }
+
+        // return the number of elements in the heap.
+        // Time: O(1).
+        [[nodiscard]] size_t size() const noexcept {
+            return nodes.size();
+        }
+
+        // return true iff the heap is empty.
+        // Time: O(1).
+        [[nodiscard]] bool empty() const noexcept {
+            return nodes.empty();
+        }
+
+        // return true iff the given element is in the priority queue.
+        // Time: O(1).
+        [[nodiscard]] bool contains(const size_t element) const noexcept {
+            return index[element] != npos;
+        }
+
+        // return the value of the key of the given element.
+        // Time: O(1).
+        [[nodiscard]] const Key& key_at(const size_t element) const noexcept {
+            return keys[element];
+        }
+
+        // add a new element to the heap and associates the given key to it.
+        // The element must not be in the priority queue.
+        // Time: O(logN).
+        void push(const Key& key, const size_t element) {
+            assert(!contains(element));
+
+            keys[element] = key;
+            index[element] = nodes.size();
+            nodes.push_back(element);
+            heapify_up(nodes.size() - 1);
+        }
+
+        // update the key of an element in the priority queue. Unlike PriorityQueue::update_key,
+        // the new key may either increase or decrease the priority of the element.
+        // The element must exist in the priority queue.
+        // Time: O(logN).
+        void update_key(const Key& key, const size_t element) {
+            assert(contains(element));
+
+            keys[element] = key;
+            heapify(index[element]);
+        }
+
+        // return the top element.
+        // Time: O(1).
+        [[nodiscard]] size_t top() const {
+            assert(!empty());
+
+            return nodes.front();
+        }
+
+        // return top key-value pair.
+        // Time: O(1).
+        [[nodiscard]] std::pair<Key, size_t> top_key_value() const {
+            const size_t top_value = top();
+            return {keys[top_value], top_value};
+        }
+
+        // remove the top element.
+        // Time: O(logN).
+        void pop() {
+            erase(top());
+        }
+
+        // remove the given element from the priority queue.
+        // The element must exist in the priority queue.
+        // Time: O(logN).
+        void erase(const size_t element) {
+            assert(contains(element));
+
+            const size_t i = index[element];
+            const size_t last = nodes.size() - 1;
+
+            if (i != last) {
+                swap_nodes(i, last);
+            }
+
+            nodes.pop_back();
+            index[element] = npos;
+
+            // the node moved in place of the removed element may violate the heap property
+            if (i < nodes.size()) {
+                heapify(i);
+            }
+        }
+
+        // remove every element from the priority queue, keeping the allocated memory.
+        // Time: O(N).
+        void clear() noexcept {
+            for (const size_t element : nodes) {
+                index[element] = npos;
+            }
+
+            nodes.clear();
+        }
+    };
+
+    // create an empty Indexed Priority Queue based on a Min Heap
+    template <typename Key>
+    auto make_min_indexed_priority_queue(const size_t capacity) {
+        return IndexedPriorityQueue<Key, std::less<>>(capacity);
+    }
+
+    // create an empty Indexed Priority Queue based on a Max Heap
+    template <typename Key>
+    auto make_max_indexed_priority_queue(const size_t capacity) {
+        return IndexedPriorityQueue<Key, std::greater<>>(capacity);
+    }
+}  // namespace priority_queue
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>  // std::fill
+#include <cassert>    // std::assert
+#include <limits>     // std::numeric_limits
+#include <vector>     // std::vector
+
+/**
+ * LinkedTour represents a partial Hamiltonian circuit over the vertexes in [0, capacity) as a
+ * doubly linked list stored in two flat arrays, next and prev. It's meant to be used while a tour
+ * is being constructed: adding or removing a vertex takes O(1), whereas inserting an element in
+ * the middle of a std::vector takes O(n).
+ */
+class LinkedTour {
+    // index value used to mark vertexes that aren't in the tour
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // next[v] is the successor of v in the tour, or npos if v isn't in the tour
+    std::vector<size_t> next_nodes;
+
+    // prev[v] is the predecessor of v in the tour, or npos if v isn't in the tour
+    std::vector<size_t> prev_nodes;
+
+    // number of vertexes in the tour
+    size_t n_nodes = 0;
+
+    // any vertex in the tour, used as the starting point of the traversals
+    size_t head = npos;
+
+public:
+    // create an empty tour that can store the vertexes in [0, capacity)
+    explicit LinkedTour(const size_t capacity) :
+        next_nodes(capacity, npos), prev_nodes(capacity, npos) {
+    }
+
+    // create a tour that visits the given vertexes in order
+    LinkedTour(const size_t capacity, const std::vector<size_t>& circuit) : LinkedTour(capacity) {
+        assign(circuit);
+    }
+
+    // replace the tour with one that visits the given vertexes in order, reusing the allocated
+    // memory
+    // Time: O(capacity)
+    void assign(const std::vector<size_t>& circuit) noexcept {
+        std::fill(next_nodes.begin(), next_nodes.end(), npos);
+        std::fill(prev_nodes.begin(), prev_nodes.end(), npos);
+
+        const size_t size = circuit.size();
+        for (size_t i = 0; i < size; ++i) {
+            const size_t from = circuit[i];
+            const size_t to = circuit[(i + 1) % size];
+            next_nodes[from] = to;
+            prev_nodes[to] = from;
+        }
+
+        n_nodes = size;
+        head = size > 0 ? circuit.front() : npos;
+    }
+
+    // return the number of vertexes in the tour
+    [[nodiscard]] size_t size() const noexcept {
+        return n_nodes;
+    }
+
+    // return true iff v is in the tour
+    [[nodiscard]] bool contains(const size_t v) const noexcept {
+        return next_nodes[v] != npos;
+    }
+
+    // return any vertex in the tour. The tour must not be empty.
+    [[nodiscard]] size_t front() const noexcept {
+        return head;
+    }
+
+    // return the successor of v, which must be in the tour
+    [[nodiscard]] size_t next(const size_t v) const noexcept {
+        return next_nodes[v];
+    }
+
+    // return the predecessor of v, which must be in the tour
+    [[nodiscard]] size_t prev(const size_t v) const noexcept {
+        return prev_nodes[v];
+    }
+
+    // add k in between i and next(i). i must be in the tour, k must not.
+    // Time: O(1)
+    void insert_after(const size_t i, const size_t k) noexcept {
+        assert(contains(i) && !contains(k));
+
+        const size_t j = next_nodes[i];
+        next_nodes[i] = k;
+        prev_nodes[k] = i;
+        next_nodes[k] = j;
+        prev_nodes[j] = k;
+        ++n_nodes;
+    }
+
+    // remove k from the tour, joining prev(k) and next(k). k must be in the tour.
+    // Time: O(1)
+    void erase(const size_t k) noexcept {
+        assert(contains(k));
+
+        const size_t i = prev_nodes[k];
+        const size_t j = next_nodes[k];
+        next_nodes[i] = j;
+        prev_nodes[j] = i;
+        next_nodes[k] = npos;
+        prev_nodes[k] = npos;
+        --n_nodes;
+
+        if (head == k) {
+            head = n_nodes > 0 ? j : npos;
+        }
+    }
+
+    // call f(i, j) for every arc (i, j) in the tour
+    // Time: O(n)
+    template <typename Function>
+    void for_each_arc(Function&& f) const {
+        size_t i = head;
+        for (size_t count = 0; count < n_nodes; ++count) {
+            const size_t j = next_nodes[i];
+            f(i, j);
+            i = j;
+        }
+    }
+
+    // store the vertexes of the tour in circuit, in order, starting from start. The memory
+    // already allocated by circuit is reused.
+    // Time: O(n)
+    void copy_to(std::vector<size_t>& circuit, const size_t start) const {
+        circuit.clear();
+
+        size_t v = start;
+        for (size_t count = 0; count < n_nodes; ++count) {
+            circuit.push_back(v);
+            v = next_nodes[v];
+        }
+    }
+
+    // return the vertexes of the tour in order, starting from start
+    // Time: O(n)
+    [[nodiscard]] std::vector<size_t> to_vector(const size_t start) const {
+        std::vector<size_t> circuit;
+        circuit.reserve(n_nodes);
+        copy_to(circuit, start);
+        return circuit;
+    }
+
+    // return the vertexes of the tour in order
+    // Time: O(n)
+    [[nodiscard]] std::vector<size_t> to_vector() const {
+        return to_vector(head);
+    }
+};
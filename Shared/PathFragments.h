@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>  // std::sort
+#include <limits>     // std::numeric_limits
+#include <vector>     // std::vector
+
+#include "UnionFind.h"
+
+/**
+ * PathFragments keeps a set of vertex-disjoint paths over the vertexes in [0, capacity), which
+ * are grown by linking their endpoints. It's used by the construction heuristics that build a
+ * tour one edge at a time, such as Savings and Greedy Edge: an edge (i, j) can be added iff both
+ * i and j have degree less than 2 and they're in different fragments, otherwise a vertex would
+ * have degree 3 or a cycle would be closed too early.
+ * Every vertex starts as a fragment on its own.
+ */
+class PathFragments {
+    // index value used to mark missing neighbors
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // adjacent[2v] and adjacent[2v + 1] are the neighbors of v in its fragment, or npos
+    std::vector<size_t> adjacent;
+
+    // degree[v] is the number of neighbors of v, either 0, 1 or 2
+    std::vector<unsigned char> degree;
+
+    // keep track of the vertexes in the same fragment
+    UnionFind components;
+
+public:
+    explicit PathFragments(const size_t capacity) :
+        adjacent(2 * capacity, npos), degree(capacity, 0), components(capacity) {
+    }
+
+    // return the number of neighbors of v
+    [[nodiscard]] size_t degree_of(const size_t v) const noexcept {
+        return degree[v];
+    }
+
+    // return true iff v is an endpoint of its fragment, i.e. it has degree less than 2
+    [[nodiscard]] bool is_endpoint(const size_t v) const noexcept {
+        return degree[v] < 2;
+    }
+
+    // return true iff the edge (i, j) can be added without creating a vertex of degree 3 or a
+    // cycle
+    [[nodiscard]] bool can_link(const size_t i, const size_t j) noexcept {
+        return i != j && is_endpoint(i) && is_endpoint(j) && !components.connected(i, j);
+    }
+
+    // add the edge (i, j), if it's allowed. Return true iff the edge has been added.
+    bool link(const size_t i, const size_t j) noexcept {
+        if (!can_link(i, j)) {
+            return false;
+        }
+
+        adjacent[2 * i + degree[i]++] = j;
+        adjacent[2 * j + degree[j]++] = i;
+        components.unite(i, j);
+        return true;
+    }
+
+    /**
+     * Return the vertexes of the fragment that starts from the endpoint v, in path order.
+     * Time: O(length of the fragment)
+     */
+    [[nodiscard]] std::vector<size_t> path_from(const size_t v) const {
+        std::vector<size_t> path{v};
+
+        size_t prev = npos;
+        size_t curr = v;
+        while (true) {
+            const size_t a = adjacent[2 * curr];
+            const size_t b = adjacent[2 * curr + 1];
+            const size_t next = a != prev ? a : b;
+
+            if (next == npos) {
+                break;
+            }
+
+            path.push_back(next);
+            prev = curr;
+            curr = next;
+        }
+
+        return path;
+    }
+
+    /**
+     * Join the fragments whose endpoints are listed in endpoints into a single path, adding the
+     * allowed edges among those endpoints in decreasing order of priority(i, j).
+     * Since every pair of endpoints is considered, exactly one fragment is left at the end.
+     * Time: O(f^2 log f), where f is the number of endpoints.
+     *
+     * @param endpoints the endpoints of the fragments to join.
+     * @param priority function that returns the priority of the edge (i, j).
+     */
+    template <typename Priority>
+    void join(const std::vector<size_t>& endpoints, Priority&& priority) {
+        struct candidate {
+            int priority;
+            size_t i;
+            size_t j;
+        };
+
+        std::vector<candidate> candidates;
+        const size_t n_endpoints = endpoints.size();
+        for (size_t x = 0; x < n_endpoints; ++x) {
+            for (size_t y = x + 1; y < n_endpoints; ++y) {
+                const size_t i = endpoints[x];
+                const size_t j = endpoints[y];
+                if (can_link(i, j)) {
+                    candidates.push_back({priority(i, j), i, j});
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+            return a.priority > b.priority;
+        });
+
+        for (const auto& [_, i, j] : candidates) {
+            link(i, j);
+        }
+    }
+};
@@ -16,9 +16,6 @@ namespace point_reader {
         std::fstream& file;
         size_t dimension;
 
-        // calculate the distance between the i-th and the j-th points
-        virtual int distance(size_t i, size_t j) const = 0;
-
     public:
         PointReader(std::fstream& file, size_t dimension) : file(file), dimension(dimension) {
         }
@@ -28,6 +25,18 @@ namespace point_reader {
         // consume the list of points from the input file
         virtual void read() = 0;
 
+        // return the number of points
+        [[nodiscard]] size_t size() const noexcept {
+            return dimension;
+        }
+
+        // calculate the distance between the i-th and the j-th points
+        [[nodiscard]] virtual int distance(size_t i, size_t j) const = 0;
+
+        // return the points mapped to the plane, for the algorithms based on their geometry.
+        // Distances on the plane only approximate the ones returned by distance.
+        [[nodiscard]] virtual std::vector<point::point_2D> planar_points() const = 0;
+
         // create a distance matrix after reading the points. It uses the distance method
         // implemented by the child classes as an higher-order function
         DistanceMatrix<int> create_distance_matrix() {
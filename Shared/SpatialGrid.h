@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>  // std::min, std::max, std::minmax_element
+#include <cmath>      // std::ceil, std::floor, std::sqrt
+#include <vector>     // std::vector
+
+#include "point.h"  // point::point_2D
+
+/**
+ * SpatialGrid is a uniform bucket grid over a fixed set of 2D points. Each point is assigned to
+ * the square cell that contains it, and the points of each cell are stored contiguously
+ * (compressed sparse row layout). The grid is sized so that each cell holds a small constant
+ * number of points on average, which makes radius and nearest-neighbor queries cost time
+ * proportional to the number of points in the area that is searched.
+ * The grid is static: callers that need to ignore some points (e.g. the ones already in the
+ * tour) should filter them in the visitor function.
+ */
+class SpatialGrid {
+    const std::vector<point::point_2D>& points;
+
+    // coordinates of the bottom-left corner of the grid
+    double min_x = 0;
+    double min_y = 0;
+
+    // side of each square cell
+    double cell_size = 1;
+
+    size_t n_columns = 1;
+    size_t n_rows = 1;
+
+    // the points of the cell c are cell_points[cell_start[c]], ..., cell_points[cell_start[c+1]-1]
+    std::vector<size_t> cell_start;
+    std::vector<size_t> cell_points;
+
+    [[nodiscard]] size_t clamp_column(const double x) const noexcept {
+        const double column = std::floor((x - min_x) / cell_size);
+        return static_cast<size_t>(std::min(std::max(column, 0.0), double(n_columns - 1)));
+    }
+
+    [[nodiscard]] size_t clamp_row(const double y) const noexcept {
+        const double row = std::floor((y - min_y) / cell_size);
+        return static_cast<size_t>(std::min(std::max(row, 0.0), double(n_rows - 1)));
+    }
+
+    [[nodiscard]] size_t cell_index(const size_t column, const size_t row) const noexcept {
+        return row * n_columns + column;
+    }
+
+    [[nodiscard]] static double squared_distance(const point::point_2D& a,
+                                                 const point::point_2D& b) noexcept {
+        const double x = a.x - b.x;
+        const double y = a.y - b.y;
+        return x * x + y * y;
+    }
+
+public:
+    /**
+     * @param points the points to index. They must outlive the grid.
+     * @param points_per_cell average number of points stored in each cell.
+     */
+    explicit SpatialGrid(const std::vector<point::point_2D>& points,
+                         const double points_per_cell = 2.0) :
+        points(points) {
+        const size_t size = points.size();
+        if (size == 0) {
+            cell_start.assign(2, 0);
+            return;
+        }
+
+        const auto [it_min_x, it_max_x] = std::minmax_element(
+            points.cbegin(), points.cend(), [](const auto& a, const auto& b) {
+                return a.x < b.x;
+            });
+        const auto [it_min_y, it_max_y] = std::minmax_element(
+            points.cbegin(), points.cend(), [](const auto& a, const auto& b) {
+                return a.y < b.y;
+            });
+
+        min_x = it_min_x->x;
+        min_y = it_min_y->y;
+        const double width = std::max(it_max_x->x - min_x, 1e-9);
+        const double height = std::max(it_max_y->y - min_y, 1e-9);
+
+        // choose the cell side so that the grid has about size / points_per_cell cells. When the
+        // bounding box is thin, the longer side alone must not be split in more than n_cells
+        // cells, otherwise the grid would have far more cells than points.
+        const double n_cells = std::max(1.0, size / points_per_cell);
+        cell_size = std::max({std::sqrt(width * height / n_cells),
+                              std::max(width, height) / n_cells, 1e-9});
+        n_columns = static_cast<size_t>(std::ceil(width / cell_size)) + 1;
+        n_rows = static_cast<size_t>(std::ceil(height / cell_size)) + 1;
+
+        // counting sort of the points by cell
+        std::vector<size_t> point_cell(size);
+        cell_start.assign(n_columns * n_rows + 1, 0);
+        for (size_t v = 0; v < size; ++v) {
+            point_cell[v] = cell_index(clamp_column(points[v].x), clamp_row(points[v].y));
+            ++cell_start[point_cell[v] + 1];
+        }
+
+        for (size_t c = 1; c < cell_start.size(); ++c) {
+            cell_start[c] += cell_start[c - 1];
+        }
+
+        std::vector<size_t> fill(cell_start.cbegin(), cell_start.cend() - 1);
+        cell_points.resize(size);
+        for (size_t v = 0; v < size; ++v) {
+            cell_points[fill[point_cell[v]]++] = v;
+        }
+    }
+
+    // return the side of each cell
+    [[nodiscard]] double get_cell_size() const noexcept {
+        return cell_size;
+    }
+
+    // return the maximum ring index that may contain any cell
+    [[nodiscard]] size_t max_ring() const noexcept {
+        return std::max(n_columns, n_rows);
+    }
+
+    // return true iff every cell of the given ring around the cell that contains p is outside of
+    // the grid, and so are the cells of the following rings
+    [[nodiscard]] bool is_past_grid(const point::point_2D& p, const size_t ring) const noexcept {
+        const size_t column = clamp_column(p.x);
+        const size_t row = clamp_row(p.y);
+        return ring > column && ring > row && column + ring >= n_columns && row + ring >= n_rows;
+    }
+
+    // call f(v) for every point v whose Euclidean distance from p is at most radius
+    template <typename Function>
+    void for_each_in_radius(const point::point_2D& p, const double radius, Function&& f) const {
+        const size_t first_column = clamp_column(p.x - radius);
+        const size_t last_column = clamp_column(p.x + radius);
+        const size_t first_row = clamp_row(p.y - radius);
+        const size_t last_row = clamp_row(p.y + radius);
+        const double squared_radius = radius * radius;
+
+        for (size_t row = first_row; row <= last_row; ++row) {
+            for (size_t column = first_column; column <= last_column; ++column) {
+                const size_t c = cell_index(column, row);
+                for (size_t i = cell_start[c]; i < cell_start[c + 1]; ++i) {
+                    const size_t v = cell_points[i];
+                    if (squared_distance(points[v], p) <= squared_radius) {
+                        f(v);
+                    }
+                }
+            }
+        }
+    }
+
+    // call f(v) for every point v stored in the cells at Chebyshev distance ring from the cell
+    // that contains p. Ring 0 is the cell of p itself.
+    template <typename Function>
+    void for_each_in_ring(const point::point_2D& p, const size_t ring, Function&& f) const {
+        const auto column = static_cast<long long>(clamp_column(p.x));
+        const auto row = static_cast<long long>(clamp_row(p.y));
+        const auto r = static_cast<long long>(ring);
+
+        const auto last_column = static_cast<long long>(n_columns) - 1;
+        const auto last_row = static_cast<long long>(n_rows) - 1;
+
+        const auto visit = [&](const long long x, const long long y) {
+            const size_t c = cell_index(static_cast<size_t>(x), static_cast<size_t>(y));
+            for (size_t i = cell_start[c]; i < cell_start[c + 1]; ++i) {
+                f(cell_points[i]);
+            }
+        };
+
+        if (r == 0) {
+            visit(column, row);
+            return;
+        }
+
+        // only the part of the ring inside of the grid is visited, so a ring costs
+        // O(n_columns + n_rows) at most, even when it's much larger than the grid
+        const long long first_x = std::max(column - r, 0LL);
+        const long long last_x = std::min(column + r, last_column);
+        const long long first_y = std::max(row - r + 1, 0LL);
+        const long long last_y = std::min(row + r - 1, last_row);
+
+        // top and bottom sides of the ring, corners included
+        for (long long x = first_x; x <= last_x; ++x) {
+            if (row - r >= 0) {
+                visit(x, row - r);
+            }
+            if (row + r <= last_row) {
+                visit(x, row + r);
+            }
+        }
+
+        // left and right sides of the ring, corners excluded
+        for (long long y = first_y; y <= last_y; ++y) {
+            if (column - r >= 0) {
+                visit(column - r, y);
+            }
+            if (column + r <= last_column) {
+                visit(column + r, y);
+            }
+        }
+    }
+};
@@ -0,0 +1,481 @@
+#pragma once
+
+#include <algorithm>  // std::max
+#include <cmath>      // std::sqrt
+#include <utility>    // std::swap
+#include <vector>     // std::vector
+
+/**
+ * TwoLevelList represents a Hamiltonian circuit over the vertexes in [0, capacity) as a circular
+ * doubly linked list of segments of about sqrt(n) vertexes. Every segment is a doubly linked list
+ * of vertexes with a reversal bit: if the bit is set, the tour visits the segment backwards.
+ * Successor, predecessor and betweenness queries take O(1), and reversing a path takes
+ * O(sqrt(n)): the segments are split at the endpoints of the path, then the order of the
+ * segments in between is reversed and their reversal bits are flipped, and the pieces left by
+ * the splits are merged with their neighbors when they're small enough.
+ * The interface is the same as ArrayTour, so the local searches work with both of them. Since
+ * reversing a path of an ArrayTour takes O(n) in the worst case, TwoLevelList is faster on large
+ * graphs. The orientation of the circuit is not preserved by reverse.
+ */
+class TwoLevelList {
+    // gap between the ranks of adjacent segments after they're renumbered
+    static constexpr size_t rank_spacing = 1U << 20;
+
+    struct segment_t {
+        // if true, the tour visits the vertexes of the segment from last to first
+        bool reversed;
+
+        // first and last vertex of the segment, following the links of the segment
+        size_t first;
+        size_t last;
+
+        // number of vertexes in the segment
+        size_t size;
+
+        // ranks increase along the circular list of segments, from any starting segment, and they
+        // leave gaps so that new segments can be inserted without renumbering the others
+        size_t rank;
+
+        // previous and next segment in tour order
+        size_t prev;
+        size_t next;
+    };
+
+    // links of every vertex to its neighbors in the same segment. The links of the first and
+    // last vertex of a segment that point outside of it are meaningless.
+    std::vector<size_t> link_next;
+    std::vector<size_t> link_prev;
+
+    // parent[v] is the segment of v
+    std::vector<size_t> parent;
+
+    // seq[v] is the position of v in its segment: it increases by 1 along link_next
+    std::vector<long long> seq;
+
+    // segments and indexes of the segments not in use. Every reversal needs at most 2 new
+    // segments, and the segments are rebuilt when there aren't enough free ones.
+    std::vector<segment_t> segments;
+    std::vector<size_t> free_segments;
+
+    // size of the segments created by assign. Adjacent segments are merged when their total size
+    // doesn't exceed twice this value.
+    size_t segment_size;
+
+    // tour order, used to rebuild the segments
+    std::vector<size_t> buffer;
+
+    [[nodiscard]] size_t tour_first(const segment_t& segment) const noexcept {
+        return segment.reversed ? segment.last : segment.first;
+    }
+
+    [[nodiscard]] size_t tour_last(const segment_t& segment) const noexcept {
+        return segment.reversed ? segment.first : segment.last;
+    }
+
+    // position of v in its segment, in tour order
+    [[nodiscard]] long long tour_seq(const size_t v) const noexcept {
+        return segments[parent[v]].reversed ? -seq[v] : seq[v];
+    }
+
+    // return true iff u comes before v or u == v, starting from the segment with rank 0
+    [[nodiscard]] bool precedes(const size_t u, const size_t v) const noexcept {
+        const size_t rank_u = segments[parent[u]].rank;
+        const size_t rank_v = segments[parent[v]].rank;
+        return rank_u != rank_v ? rank_u < rank_v : tour_seq(u) <= tour_seq(v);
+    }
+
+    // set the rank of every segment, starting from s
+    // Time: O(sqrt(n))
+    void renumber(const size_t s) noexcept {
+        size_t rank = 0;
+        size_t t = s;
+        do {
+            segments[t].rank = rank;
+            rank += rank_spacing;
+            t = segments[t].next;
+        } while (t != s);
+    }
+
+    // link segment t in between the adjacent segments before and after, and rank it
+    void insert_segment(const size_t t, const size_t before, const size_t after) noexcept {
+        segments[t].prev = before;
+        segments[t].next = after;
+        segments[before].next = t;
+        segments[after].prev = t;
+
+        // the segment with the highest rank is followed by the one with the lowest rank
+        const size_t rank_before = segments[before].rank;
+        const size_t rank_after = segments[after].rank;
+        if (rank_before >= rank_after) {
+            segments[t].rank = rank_before + rank_spacing;
+        } else if (rank_after - rank_before >= 2) {
+            segments[t].rank = rank_before + (rank_after - rank_before) / 2;
+        } else {
+            renumber(t);
+        }
+    }
+
+    // split the segment of v so that v is the first vertex of its segment in tour order. The
+    // smaller part of the segment is moved to a new segment.
+    // Time: O(sqrt(n))
+    void split_before(const size_t v) noexcept {
+        const size_t s = parent[v];
+        segment_t& segment = segments[s];
+        if (v == tour_first(segment)) {
+            return;
+        }
+
+        // number of vertexes before v in the segment, in tour order
+        const long long offset = tour_seq(v) - tour_seq(tour_first(segment));
+        const auto n_before = static_cast<size_t>(offset);
+        const bool move_before = 2 * n_before <= segment.size;
+
+        // the part moved follows the links of the segment from u to w. The vertexes before v in
+        // tour order are [first, prev(v)] if the segment isn't reversed, and [next(v), last] if
+        // it is.
+        size_t u = 0;
+        size_t w = 0;
+        if (!segment.reversed) {
+            u = move_before ? segment.first : v;
+            w = move_before ? link_prev[v] : segment.last;
+        } else {
+            u = move_before ? link_next[v] : segment.first;
+            w = move_before ? segment.last : v;
+        }
+
+        const size_t t = free_segments.back();
+        free_segments.pop_back();
+
+        const size_t n_moved = move_before ? n_before : segment.size - n_before;
+        segments[t] = {segment.reversed, u, w, n_moved, 0, 0, 0};
+        for (size_t x = u;; x = link_next[x]) {
+            parent[x] = t;
+            if (x == w) {
+                break;
+            }
+        }
+
+        if (u == segment.first) {
+            segment.first = link_next[w];
+        } else {
+            segment.last = link_prev[u];
+        }
+        segment.size -= n_moved;
+
+        // the new segment goes before s if it holds the vertexes before v, otherwise after s
+        if (move_before) {
+            insert_segment(t, segment.prev, s);
+        } else {
+            insert_segment(t, s, segment.next);
+        }
+    }
+
+    // append v after the last vertex of segment s, in tour order
+    void push_back(const size_t s, const size_t v) noexcept {
+        segment_t& segment = segments[s];
+        if (!segment.reversed) {
+            link_prev[v] = segment.last;
+            link_next[segment.last] = v;
+            seq[v] = seq[segment.last] + 1;
+            segment.last = v;
+        } else {
+            link_next[v] = segment.first;
+            link_prev[segment.first] = v;
+            seq[v] = seq[segment.first] - 1;
+            segment.first = v;
+        }
+
+        parent[v] = s;
+        ++segment.size;
+    }
+
+    // prepend v before the first vertex of segment s, in tour order
+    void push_front(const size_t s, const size_t v) noexcept {
+        segment_t& segment = segments[s];
+        if (!segment.reversed) {
+            link_next[v] = segment.first;
+            link_prev[segment.first] = v;
+            seq[v] = seq[segment.first] - 1;
+            segment.first = v;
+        } else {
+            link_prev[v] = segment.last;
+            link_next[segment.last] = v;
+            seq[v] = seq[segment.last] + 1;
+            segment.last = v;
+        }
+
+        parent[v] = s;
+        ++segment.size;
+    }
+
+    // merge segment s with the next one if their total size doesn't exceed 2 * segment_size.
+    // The vertexes of the smaller segment are moved to the larger one.
+    // Time: O(sqrt(n))
+    void try_merge(const size_t s) noexcept {
+        const size_t t = segments[s].next;
+        if (s == t || segments[s].size + segments[t].size > 2 * segment_size) {
+            return;
+        }
+
+        size_t removed = s;
+        if (segments[s].size <= segments[t].size) {
+            // move the vertexes of s to the front of t, from the last one in tour order
+            const segment_t& segment = segments[s];
+            for (size_t v = tour_last(segment), i = 0; i < segment.size; ++i) {
+                const size_t prev_v = segment.reversed ? link_next[v] : link_prev[v];
+                push_front(t, v);
+                v = prev_v;
+            }
+
+            segments[segment.prev].next = t;
+            segments[t].prev = segment.prev;
+        } else {
+            // move the vertexes of t to the back of s, from the first one in tour order
+            const segment_t& segment = segments[t];
+            for (size_t v = tour_first(segment), i = 0; i < segment.size; ++i) {
+                const size_t next_v = segment.reversed ? link_prev[v] : link_next[v];
+                push_back(s, v);
+                v = next_v;
+            }
+
+            segments[s].next = segment.next;
+            segments[segment.next].prev = s;
+            removed = t;
+        }
+
+        // the ranks of the other segments are still increasing
+        free_segments.push_back(removed);
+    }
+
+    // reverse the path from a to b, which are in the same segment with a before b
+    // Time: O(sqrt(n))
+    void reverse_inside(const size_t a, const size_t b) noexcept {
+        segment_t& segment = segments[parent[a]];
+
+        // the path follows the links of the segment from u to w
+        const size_t u = segment.reversed ? b : a;
+        const size_t w = segment.reversed ? a : b;
+        const bool has_prev = u != segment.first;
+        const bool has_next = w != segment.last;
+        const size_t p = link_prev[u];
+        const size_t q = link_next[w];
+        const long long seq_sum = seq[u] + seq[w];
+
+        for (size_t x = u;;) {
+            const size_t next_x = link_next[x];
+            std::swap(link_next[x], link_prev[x]);
+            seq[x] = seq_sum - seq[x];
+            if (x == w) {
+                break;
+            }
+            x = next_x;
+        }
+
+        // p u .. w q -> p w .. u q
+        link_prev[w] = p;
+        link_next[u] = q;
+        if (has_prev) {
+            link_next[p] = w;
+        } else {
+            segment.first = w;
+        }
+        if (has_next) {
+            link_prev[q] = u;
+        } else {
+            segment.last = u;
+        }
+    }
+
+    // reverse the order of the segments from s to t in tour order, and flip their reversal bits
+    // Time: O(sqrt(n))
+    void reverse_segments(const size_t s, const size_t t) noexcept {
+        const size_t p = segments[s].prev;
+        const size_t q = segments[t].next;
+
+        // the reversed segments take the same ranks, in the opposite order
+        for (size_t x = s, y = t; x != y;) {
+            std::swap(segments[x].rank, segments[y].rank);
+            if (segments[x].next == y) {
+                break;
+            }
+            x = segments[x].next;
+            y = segments[y].prev;
+        }
+
+        for (size_t x = s;;) {
+            segment_t& segment = segments[x];
+            const size_t next_x = segment.next;
+            std::swap(segment.next, segment.prev);
+            segment.reversed = !segment.reversed;
+            if (x == t) {
+                break;
+            }
+            x = next_x;
+        }
+
+        // p s .. t q -> p t .. s q
+        segments[s].next = q;
+        segments[t].prev = p;
+        segments[p].next = t;
+        segments[q].prev = s;
+    }
+
+    // rebuild the segments in tour order
+    // Time: O(n)
+    void rebuild() noexcept {
+        copy_to(buffer);
+        assign(buffer);
+    }
+
+public:
+    explicit TwoLevelList(const size_t capacity) :
+        link_next(capacity),
+        link_prev(capacity),
+        parent(capacity),
+        seq(capacity),
+        segment_size(std::max<size_t>(8, static_cast<size_t>(std::sqrt(capacity) / 2))),
+        buffer(capacity) {
+        const size_t max_segments = 2 * (capacity / segment_size + 1) + 2;
+        segments.resize(max_segments);
+        free_segments.reserve(max_segments);
+    }
+
+    // replace the tour with circuit, which must visit every vertex in [0, capacity) exactly once.
+    // The memory already allocated is reused.
+    // Time: O(n)
+    void assign(const std::vector<size_t>& circuit) noexcept {
+        const size_t size = parent.size();
+        const size_t n_segments = (size + segment_size - 1) / segment_size;
+
+        for (size_t s = 0; s < n_segments; ++s) {
+            const size_t begin = s * segment_size;
+            const size_t end = std::min(begin + segment_size, size);
+
+            for (size_t i = begin; i < end; ++i) {
+                const size_t v = circuit[i];
+                link_prev[v] = circuit[i == begin ? end - 1 : i - 1];
+                link_next[v] = circuit[i + 1 == end ? begin : i + 1];
+                parent[v] = s;
+                seq[v] = static_cast<long long>(i - begin);
+            }
+
+            segments[s] = {false, circuit[begin], circuit[end - 1], end - begin, s * rank_spacing,
+                           s == 0 ? n_segments - 1 : s - 1, s + 1 == n_segments ? 0 : s + 1};
+        }
+
+        free_segments.clear();
+        for (size_t s = segments.size(); s > n_segments; --s) {
+            free_segments.push_back(s - 1);
+        }
+    }
+
+    // write the vertexes in tour order to circuit, starting from vertex 0
+    // Time: O(n)
+    void copy_to(std::vector<size_t>& circuit) const {
+        const size_t size = parent.size();
+        circuit.resize(size);
+
+        size_t v = 0;
+        for (size_t i = 0; i < size; ++i) {
+            circuit[i] = v;
+            v = next(v);
+        }
+    }
+
+    // return the number of vertexes in the tour
+    [[nodiscard]] size_t size() const noexcept {
+        return parent.size();
+    }
+
+    // return the vertex that follows v in the tour
+    [[nodiscard]] size_t next(const size_t v) const noexcept {
+        const segment_t& segment = segments[parent[v]];
+        if (v == tour_last(segment)) {
+            return tour_first(segments[segment.next]);
+        }
+
+        return segment.reversed ? link_prev[v] : link_next[v];
+    }
+
+    // return the vertex that precedes v in the tour
+    [[nodiscard]] size_t prev(const size_t v) const noexcept {
+        const segment_t& segment = segments[parent[v]];
+        if (v == tour_first(segment)) {
+            return tour_last(segments[segment.prev]);
+        }
+
+        return segment.reversed ? link_next[v] : link_prev[v];
+    }
+
+    // return true iff b is met while going forward from a to c, a and c included
+    [[nodiscard]] bool between(const size_t a, const size_t b, const size_t c) const noexcept {
+        return precedes(a, c) ? precedes(a, b) && precedes(b, c)
+                              : precedes(a, b) || precedes(b, c);
+    }
+
+    /**
+     * Reverse the path that goes forward from a to b. If the path spans more segments than its
+     * complement, the complement is reversed instead, which yields the same circuit traversed
+     * the other way.
+     * Time: O(sqrt(n)), plus O(n) when the segments are rebuilt, which happens after O(sqrt(n))
+     *       reversals that don't merge the pieces they split.
+     */
+    void reverse(const size_t a, const size_t b) noexcept {
+        // reversing the whole tour doesn't change the circuit
+        if (a == b || next(b) == a) {
+            return;
+        }
+
+        if (parent[a] == parent[b] && tour_seq(a) <= tour_seq(b)) {
+            reverse_inside(a, b);
+            return;
+        }
+
+        if (free_segments.size() < 2) {
+            rebuild();
+        }
+
+        split_before(a);
+        split_before(next(b));
+
+        // walk the path and its complement at the same time, until the shorter one ends
+        const size_t s = parent[a];
+        const size_t t = parent[b];
+        const size_t complement_s = segments[t].next;
+        const size_t complement_t = segments[s].prev;
+
+        for (size_t x = s, y = complement_s;;) {
+            if (x == t) {
+                reverse_segments(s, t);
+                break;
+            }
+            if (y == complement_t) {
+                reverse_segments(complement_s, complement_t);
+                break;
+            }
+
+            x = segments[x].next;
+            y = segments[y].next;
+        }
+
+        // the pieces left by the splits are next to a and b
+        try_merge(segments[parent[a]].prev);
+        try_merge(parent[a]);
+        try_merge(segments[parent[b]].prev);
+        try_merge(parent[b]);
+    }
+
+    /**
+     * Replace the tour edges (a, b) and (c, d) with (a, c) and (b, d), where a, b, c and d are
+     * met in this order along one of the 2 directions of the tour. See ArrayTour::exchange.
+     * Time: same as reverse.
+     */
+    void exchange(const size_t a, const size_t b, const size_t c,
+                  [[maybe_unused]] const size_t d) noexcept {
+        if (next(a) == b) {
+            reverse(b, c);
+        } else {
+            reverse(c, b);
+        }
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>  // std::vector
+
+/**
+ * UndoableTour wraps an ArrayTour or a TwoLevelList and records every change made through it,
+ * so that the changes made since the last commit can be undone in time proportional to their
+ * own cost, instead of copying the whole tour. It exposes the same queries and moves as the
+ * tour it wraps, so the local searches can work on it directly.
+ * A reversal of the path a..b is recorded as the exchange of the tour edges (prev(a), a) and
+ * (b, next(b)), and an exchange is undone by the exchange that restores its edges.
+ */
+template <class Tour>
+class UndoableTour {
+    // the tour edges (a, b) and (c, d) replaced by (a, c) and (b, d)
+    struct exchange_t {
+        size_t a;
+        size_t b;
+        size_t c;
+        size_t d;
+    };
+
+    // the tour wrapped
+    Tour& tour;
+
+    // exchanges made since the last commit
+    std::vector<exchange_t> journal;
+
+public:
+    explicit UndoableTour(Tour& tour) : tour(tour) {
+    }
+
+    // return the number of vertexes in the tour
+    [[nodiscard]] size_t size() const noexcept {
+        return tour.size();
+    }
+
+    // return the vertex that follows v in the tour
+    [[nodiscard]] size_t next(const size_t v) const noexcept {
+        return tour.next(v);
+    }
+
+    // return the vertex that precedes v in the tour
+    [[nodiscard]] size_t prev(const size_t v) const noexcept {
+        return tour.prev(v);
+    }
+
+    // return true iff b is met while going forward from a to c, a and c included
+    [[nodiscard]] bool between(const size_t a, const size_t b, const size_t c) const noexcept {
+        return tour.between(a, b, c);
+    }
+
+    // reverse the path that goes forward from a to b, and record it
+    void reverse(const size_t a, const size_t b) {
+        const size_t p = tour.prev(a);
+        const size_t q = tour.next(b);
+        tour.reverse(a, b);
+        journal.push_back({p, a, b, q});
+    }
+
+    // replace the tour edges (a, b) and (c, d) with (a, c) and (b, d), and record it
+    void exchange(const size_t a, const size_t b, const size_t c, const size_t d) {
+        tour.exchange(a, b, c, d);
+        journal.push_back({a, b, c, d});
+    }
+
+    // keep the changes recorded so far, which can't be undone anymore
+    void commit() noexcept {
+        journal.clear();
+    }
+
+    // undo the changes made since the last commit, in reverse order
+    void undo() noexcept {
+        while (!journal.empty()) {
+            // a c .. b d -> a b .. c d
+            const auto [a, b, c, d] = journal.back();
+            tour.exchange(a, c, b, d);
+            journal.pop_back();
+        }
+    }
+};
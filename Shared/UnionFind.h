@@ -0,0 +1,57 @@
+#pragma once
+
+#include <numeric>  // std::iota
+#include <utility>  // std::swap
+#include <vector>   // std::vector
+
+/**
+ * UnionFind represents a partition of the elements in [0, capacity) in disjoint sets.
+ * It uses union by size and path halving, so every operation takes O(α(n)) amortized time.
+ */
+class UnionFind {
+    // parent[v] is the parent of v in the tree of its set. Roots are their own parent.
+    std::vector<size_t> parent;
+
+    // set_size[r] is the number of elements in the set rooted in r
+    std::vector<size_t> set_size;
+
+public:
+    // create capacity singleton sets
+    explicit UnionFind(const size_t capacity) : parent(capacity), set_size(capacity, 1) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    // return the representative of the set that contains v
+    [[nodiscard]] size_t find(size_t v) noexcept {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+
+        return v;
+    }
+
+    // return true iff u and v are in the same set
+    [[nodiscard]] bool connected(const size_t u, const size_t v) noexcept {
+        return find(u) == find(v);
+    }
+
+    // merge the sets that contain u and v. Return false if they were already in the same set.
+    bool unite(const size_t u, const size_t v) noexcept {
+        size_t root_u = find(u);
+        size_t root_v = find(v);
+
+        if (root_u == root_v) {
+            return false;
+        }
+
+        // attach the smaller tree to the root of the larger one
+        if (set_size[root_u] < set_size[root_v]) {
+            std::swap(root_u, root_v);
+        }
+
+        parent[root_v] = root_u;
+        set_size[root_u] += set_size[root_v];
+        return true;
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <limits>   // std::numeric_limits
+#include <numeric>  // std::iota
+#include <vector>   // std::vector
+
+/**
+ * VertexSet represents a set of vertexes labelled in [0, capacity).
+ * Membership tests, insertions and removals take O(1) without hashing, and the elements are stored
+ * contiguously so that they can be scanned as fast as a std::vector.
+ * The iteration order is not specified, and it changes after every removal.
+ */
+class VertexSet {
+    // index value used to mark vertexes that aren't in the set
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    // vertexes in the set
+    std::vector<size_t> elements;
+
+    // index[v] -> index in elements of v, or npos if v isn't in the set
+    std::vector<size_t> index;
+
+public:
+    using const_iterator = std::vector<size_t>::const_iterator;
+
+    // create an empty set that can store the vertexes in [0, capacity)
+    explicit VertexSet(const size_t capacity) : index(capacity, npos) {
+        elements.reserve(capacity);
+    }
+
+    // create a set with every vertex in [0, capacity)
+    [[nodiscard]] static VertexSet full(const size_t capacity) {
+        VertexSet set(capacity);
+        set.fill();
+        return set;
+    }
+
+    // add every vertex in [0, capacity) to the set, reusing the allocated memory
+    // Time: O(capacity)
+    void fill() {
+        elements.resize(index.size());
+        std::iota(elements.begin(), elements.end(), 0);
+        std::iota(index.begin(), index.end(), 0);
+    }
+
+    // return the number of vertexes in the set
+    [[nodiscard]] size_t size() const noexcept {
+        return elements.size();
+    }
+
+    // return true iff the set is empty
+    [[nodiscard]] bool empty() const noexcept {
+        return elements.empty();
+    }
+
+    // return true iff v is in the set
+    [[nodiscard]] bool contains(const size_t v) const noexcept {
+        return index[v] != npos;
+    }
+
+    // return the i-th vertex stored in the set, with i in [0, size)
+    [[nodiscard]] size_t operator[](const size_t i) const noexcept {
+        return elements[i];
+    }
+
+    // add v to the set, if it isn't already there
+    void insert(const size_t v) {
+        if (!contains(v)) {
+            index[v] = elements.size();
+            elements.push_back(v);
+        }
+    }
+
+    // remove v from the set, if it's there. The last vertex takes the place of v.
+    void erase(const size_t v) noexcept {
+        if (!contains(v)) {
+            return;
+        }
+
+        const size_t i = index[v];
+        const size_t last = elements.back();
+        elements[i] = last;
+        index[last] = i;
+
+        elements.pop_back();
+        index[v] = npos;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept {
+        return elements.cbegin();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept {
+        return elements.cend();
+    }
+};
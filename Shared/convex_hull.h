@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>  // std::sort
+#include <numeric>    // std::iota
+#include <vector>     // std::vector
+
+#include "point.h"  // point::point_2D
+
+namespace geometry {
+    // return the z component of the cross product (a - o) x (b - o). It's positive if o, a, b
+    // make a counter-clockwise turn, negative if they make a clockwise turn, 0 if they're
+    // collinear.
+    [[nodiscard]] inline double cross(const point::point_2D& o, const point::point_2D& a,
+                                      const point::point_2D& b) noexcept {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    }
+
+    /**
+     * Compute the convex hull of the given points with Andrew's monotone chain algorithm.
+     * Return the indexes of the hull vertexes in counter-clockwise order. Collinear points on the
+     * hull edges and duplicate points are left out.
+     * Time: O(n log n)
+     */
+    [[nodiscard]] inline std::vector<size_t> convex_hull(
+        const std::vector<point::point_2D>& points) {
+        const size_t size = points.size();
+
+        // sort the indexes of the points lexicographically by (x, y)
+        std::vector<size_t> sorted(size);
+        std::iota(sorted.begin(), sorted.end(), 0);
+        std::sort(sorted.begin(), sorted.end(), [&points](const size_t i, const size_t j) {
+            const auto& [x_i, y_i] = points[i];
+            const auto& [x_j, y_j] = points[j];
+            return x_i < x_j || (x_i == x_j && y_i < y_j);
+        });
+
+        if (size < 3) {
+            return sorted;
+        }
+
+        std::vector<size_t> hull(2 * size);
+        size_t k = 0;
+
+        // remove the last hull vertex while it doesn't make a counter-clockwise turn with p
+        const auto push = [&](const size_t p, const size_t min_size) {
+            while (k >= min_size &&
+                   cross(points[hull[k - 2]], points[hull[k - 1]], points[p]) <= 0) {
+                --k;
+            }
+            hull[k++] = p;
+        };
+
+        // build the lower hull
+        for (size_t i = 0; i < size; ++i) {
+            push(sorted[i], 2);
+        }
+
+        // build the upper hull
+        const size_t lower_size = k + 1;
+        for (size_t i = size - 1; i > 0; --i) {
+            push(sorted[i - 1], lower_size);
+        }
+
+        // the last vertex is the same as the first one
+        hull.resize(k - 1);
+        return hull;
+    }
+}  // namespace geometry
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>  // std::array
+
+namespace local_search {
+    /**
+     * Local double bridge kick: the 2 consecutive segments b1..b2 and c1..c2 that follow a1 are
+     * swapped, so a1 b1..b2 c1..c2 d1 becomes a1 c1..c2 b1..b2 d1. It's the classic
+     * perturbation of iterated local searches, since 2-opt, Or-opt and Lin-Kernighan can't undo
+     * it with a single sequential move. With short segments, the kick only changes the tour
+     * around a1 and takes time proportional to the length of the segments.
+     */
+    struct double_bridge_t {
+        size_t a1;
+        size_t b1;
+        size_t b2;
+        size_t c1;
+        size_t c2;
+        size_t d1;
+
+        /**
+         * Return the kick that swaps the length_b vertexes that follow a1 with the length_c
+         * vertexes that follow them. The tour must have at least length_b + length_c + 2
+         * vertexes.
+         * Time: O(length_b + length_c)
+         */
+        template <class Tour>
+        [[nodiscard]] static double_bridge_t after(const Tour& tour, const size_t a1,
+                                                   const size_t length_b,
+                                                   const size_t length_c) noexcept {
+            const size_t b1 = tour.next(a1);
+            size_t b2 = b1;
+            for (size_t length = length_b; length > 1; --length) {
+                b2 = tour.next(b2);
+            }
+
+            const size_t c1 = tour.next(b2);
+            size_t c2 = c1;
+            for (size_t length = length_c; length > 1; --length) {
+                c2 = tour.next(c2);
+            }
+
+            return {a1, b1, b2, c1, c2, tour.next(c2)};
+        }
+
+        // return the decrease of the tour weight due to the kick, which is usually negative
+        template <class Distance>
+        [[nodiscard]] int gain(const Distance& get_distance) const noexcept {
+            return get_distance(a1, b1) + get_distance(b2, c1) + get_distance(c2, d1) -
+                   get_distance(a1, c1) - get_distance(c2, b1) - get_distance(b2, d1);
+        }
+
+        /**
+         * Apply the kick as 3 edge exchanges, see ArrayTour::exchange and
+         * TwoLevelList::exchange. exchange(a, b, c, d) applies one of them to the tour.
+         * Time: 3 exchanges of paths no longer than the segments.
+         */
+        template <class Exchange>
+        void apply(Exchange&& exchange) const {
+            // a1 b1..b2 c1..c2 d1 -> a1 c2..c1 b2..b1 d1 -> a1 c1..c2 b2..b1 d1
+            //                     -> a1 c1..c2 b1..b2 d1
+            exchange(a1, b1, c2, d1);
+            exchange(a1, c2, c1, b2);
+            exchange(c2, b2, b1, d1);
+        }
+
+        // return the endpoints of the edges changed by the kick
+        [[nodiscard]] std::array<size_t, 6> endpoints() const noexcept {
+            return {a1, b1, b2, c1, c2, d1};
+        }
+    };
+}  // namespace local_search
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <cstdint>    // uint64_t
+
+namespace edge_hash {
+    // return a well mixed 64 bit hash of x (the finalizer of splitmix64). It's a bijection, and
+    // mix(0) = 0.
+    [[nodiscard]] constexpr uint64_t mix(uint64_t x) noexcept {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /**
+     * Return the key of the undirected edge (u, v), where u and v are less than 2^32. Different
+     * edges have different keys, no key is 0, and the bits of a key look random, so it can be
+     * used both as a hash and as the Zobrist key of the edge. The keys are computed on the fly
+     * instead of being stored in an n x n table of random numbers.
+     */
+    [[nodiscard]] inline uint64_t edge_key(const size_t u, const size_t v) noexcept {
+        const auto low = static_cast<uint64_t>(std::min(u, v));
+        const auto high = static_cast<uint64_t>(std::max(u, v));
+
+        // low <= high, so the argument of mix can't be 0
+        return mix((low << 32) ^ high ^ 0x9e3779b97f4a7c15ULL);
+    }
+}  // namespace edge_hash
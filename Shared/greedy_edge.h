@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>  // std::find
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "PathFragments.h"
+#include "nearest_neighbors.h"
+#include "parallel_sort.h"
+
+namespace greedy_edge {
+    // graphs up to this size consider every edge as a candidate, larger graphs only consider the
+    // edges to the k nearest neighbors of each node
+    constexpr size_t all_pairs_max_size = 1000;
+
+    /**
+     * Greedy Edge (or Greedy Matching) heuristic for the Metric-TSP. The candidate edges are
+     * sorted by increasing weight with a parallel sort, then every edge (i, j) is added to the
+     * tour as long as both i and j have degree less than 2 and (i, j) doesn't close a cycle
+     * early. The fragments left are joined by the shortest edges among their endpoints, and the
+     * last path is closed into a Hamiltonian circuit.
+     * Return the Hamiltonian circuit found.
+     * Time: O(m log m) for m candidate edges, where m = O(n^2) for small graphs and O(nk) for
+     *       large graphs, plus O(f^2 log f) to join the f fragment endpoints left.
+     *
+     * @param distance_matrix represents the graph as a Distance Matrix.
+     * @param k number of nearest neighbors of each node considered when the graph is large.
+     */
+    [[nodiscard]] inline std::vector<size_t> greedy_edge_circuit(
+        const DistanceMatrix<int>& distance_matrix, const size_t k = 10) {
+        const size_t size = distance_matrix.size();
+
+        // lambda function that returns the distance between any 2 nodes
+        const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+            return distance_matrix.at(x, y);
+        };
+
+        struct candidate {
+            int weight;
+            size_t i;
+            size_t j;
+        };
+
+        // Step 1: collect the candidate edges (i, j), with i < j
+        std::vector<candidate> candidates;
+
+        if (size <= all_pairs_max_size) {
+            candidates.reserve(size * (size - 1) / 2);
+            for (size_t i = 0; i < size; ++i) {
+                for (size_t j = i + 1; j < size; ++j) {
+                    candidates.push_back({get_distance(i, j), i, j});
+                }
+            }
+        } else {
+            const auto neighbors = neighbors::k_nearest_neighbors(distance_matrix, k);
+            candidates.reserve(size * k);
+
+            for (size_t i = 0; i < size; ++i) {
+                for (const size_t j : neighbors[i]) {
+                    // every pair appears once, even when i and j are neighbors of each other
+                    const bool is_duplicate =
+                        j < i && std::find(neighbors[j].cbegin(), neighbors[j].cend(), i) !=
+                                     neighbors[j].cend();
+
+                    if (!is_duplicate) {
+                        candidates.push_back({get_distance(i, j), i, j});
+                    }
+                }
+            }
+        }
+
+        // Step 2: add the candidate edges in increasing order of weight
+        utils::parallel_sort(candidates.begin(), candidates.end(),
+                             [](const auto& a, const auto& b) {
+                                 return a.weight < b.weight;
+                             });
+
+        PathFragments fragments(size);
+        for (const auto& [_, i, j] : candidates) {
+            fragments.link(i, j);
+        }
+
+        // Step 3: join the fragments left, shortest edges first
+        std::vector<size_t> endpoints;
+        for (size_t v = 0; v < size; ++v) {
+            if (fragments.is_endpoint(v)) {
+                endpoints.push_back(v);
+            }
+        }
+
+        fragments.join(endpoints, [&](const size_t i, const size_t j) {
+            return -get_distance(i, j);
+        });
+
+        // Step 4: the only path left is closed by the edge between its endpoints
+        size_t first = 0;
+        for (const size_t v : endpoints) {
+            if (fragments.is_endpoint(v)) {
+                first = v;
+                break;
+            }
+        }
+
+        return fragments.path_from(first);
+    }
+}  // namespace greedy_edge
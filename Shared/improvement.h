@@ -0,0 +1,374 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <climits>    // INT_MAX
+#include <cstring>    // std::strcmp
+#include <numeric>    // std::iota
+#include <optional>   // std::optional
+#include <thread>     // std::thread
+#include <vector>     // std::vector
+
+#include "ArrayTour.h"
+#include "DistanceMatrix.h"
+#include "TwoLevelList.h"
+#include "nearest_neighbors.h"
+#include "or_opt.h"
+#include "point.h"
+#include "shared_utils.h"
+#include "two_opt.h"
+
+/**
+ * Optional improvement stage of the construction heuristics: the circuit they build can be
+ * improved by a local search before its weight is returned. The stage is chosen on the command
+ * line with optional flags, which may appear anywhere after the program name.
+ */
+namespace improvement {
+    // every stage is a set of local searches, stored as bit flags
+    enum class Stage : unsigned {
+        // return the circuit as it has been built
+        none = 0,
+
+        // 2-opt with neighbor lists and don't-look bits, see local_search::TwoOpt
+        two_opt = 1,
+
+        // Or-opt with neighbor lists and don't-look bits, see local_search::OrOpt
+        or_opt = 2,
+
+        // 2-opt and Or-opt in turn, until neither of them improves the circuit
+        two_opt_or_opt = 3,
+    };
+
+    // return true iff stage runs every local search of part
+    [[nodiscard]] constexpr bool includes(const Stage stage, const Stage part) noexcept {
+        return (static_cast<unsigned>(stage) & static_cast<unsigned>(part)) ==
+               static_cast<unsigned>(part);
+    }
+
+    // number of nearest neighbors of each node considered by the local search
+    constexpr size_t n_neighbors = 10;
+
+    // circuits with at least this many nodes are improved on a TwoLevelList, since reversing a
+    // path of an ArrayTour takes O(n)
+    constexpr size_t two_level_list_min_size = 10000;
+
+    // circuits with at least this many nodes are split in fragments improved by several threads
+    // at once, when more than 1 CPU core is available
+    constexpr size_t parallel_min_size = 50000;
+
+    // minimum number of nodes of a fragment improved by its own thread
+    constexpr size_t min_fragment_size = 5000;
+
+    // command line flags that add 2-opt and Or-opt to the stage
+    constexpr const char* two_opt_flag = "--2opt";
+    constexpr const char* or_opt_flag = "--oropt";
+
+    // flags listed by the usage messages
+    constexpr const char* flags_usage = "--2opt, --oropt";
+
+    /**
+     * Return the improvement stage selected by the command line arguments, and remove its flags
+     * from argv, so that the program can parse its positional arguments as usual.
+     */
+    [[nodiscard]] inline Stage parse_stage(int& argc, char** argv) noexcept {
+        unsigned stage = 0;
+
+        int kept = 1;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], two_opt_flag) == 0) {
+                stage |= static_cast<unsigned>(Stage::two_opt);
+            } else if (std::strcmp(argv[i], or_opt_flag) == 0) {
+                stage |= static_cast<unsigned>(Stage::or_opt);
+            } else {
+                argv[kept++] = argv[i];
+            }
+        }
+
+        argc = kept;
+        return static_cast<Stage>(stage);
+    }
+
+    // apply the local searches of stage to tour in turn, until none of them improves it.
+    // If vertexes isn't null, every local search only starts from them and from the
+    // vertexes whose tour edges it changes. Return the total decrease of the tour weight.
+    template <class TwoOptSearch, class OrOptSearch, class Tour,
+              class Vertexes = std::vector<size_t>>
+    int optimize_tour(const Stage stage, TwoOptSearch& two_opt, OrOptSearch& or_opt,
+                      Tour& tour, const Vertexes* vertexes = nullptr) {
+        // return the decrease of the tour weight due to search
+        const auto optimize = [&tour, &vertexes](auto& search) {
+            return vertexes != nullptr ? search.optimize(tour, *vertexes)
+                                       : search.optimize(tour);
+        };
+
+        // each local search may create improving moves for the other one
+        int gain = 0;
+        int round_gain = 0;
+        do {
+            round_gain = 0;
+            if (includes(stage, Stage::two_opt)) {
+                round_gain += optimize(two_opt);
+            }
+            if (includes(stage, Stage::or_opt)) {
+                round_gain += optimize(or_opt);
+            }
+
+            gain += round_gain;
+        } while (round_gain > 0 && stage == Stage::two_opt_or_opt);
+
+        return gain;
+    }
+
+    namespace detail {
+        // weight of the edge that joins the endpoints of a path, see improve_path. It's so
+        // negative that no improving move removes it, and small enough that the gain of a move
+        // can't overflow.
+        constexpr int fixed_edge_weight = -(INT_MAX / 4);
+
+        // nodes of a path at most this far from one of its endpoints are on its border, since an
+        // Or-opt segment of 3 nodes that starts from them may cross the endpoint
+        constexpr size_t max_border_distance = 3;
+
+        /**
+         * Improve the path of the given length that starts at circuit[first] according to stage,
+         * keeping its endpoints fixed, and return the decrease of its weight. The path wraps
+         * around the end of circuit.
+         * The path is closed in a circuit of its own by an edge of weight fixed_edge_weight
+         * between its endpoints, which every improving move keeps, and only the neighbors of
+         * every node that belong to the path are considered. The improving moves left are
+         * found from the nodes of the border: the ones close to the endpoints of the path, and
+         * the ones with a neighbor either out of the path or close to its endpoints.
+         * Time: O(mk) to build the path, where m is its length and k the number of neighbors,
+         *       plus the local search.
+         *
+         * @param position position[v] is the index of v in circuit.
+         * @param border the nodes of the border are appended to it.
+         */
+        template <class Distance>
+        [[nodiscard]] int improve_path(const Stage stage, const Distance& get_distance,
+                                       const std::vector<std::vector<size_t>>& neighbors,
+                                       const std::vector<size_t>& position,
+                                       std::vector<size_t>& circuit, const size_t first,
+                                       const size_t length, std::vector<size_t>& border) {
+            const size_t size = circuit.size();
+
+            // return the index of v in the path, which is at least length if v isn't in it
+            const auto local_index = [&](const size_t v) {
+                return position[v] >= first ? position[v] - first : position[v] + size - first;
+            };
+
+            // path[i] is the i-th node of the path, which is node i of the local circuit
+            std::vector<size_t> path(length);
+            for (size_t i = 0; i < length; ++i) {
+                const size_t index = first + i;
+                path[i] = circuit[index < size ? index : index - size];
+            }
+
+            // return true iff node i of the path is close enough to an endpoint that an Or-opt
+            // segment may start from it and cross the endpoint
+            const auto close_to_endpoint = [length](const size_t i) {
+                return i < max_border_distance || i + max_border_distance >= length;
+            };
+
+            std::vector<std::vector<size_t>> path_neighbors(length);
+            for (size_t i = 0; i < length; ++i) {
+                bool is_border = close_to_endpoint(i);
+                for (const size_t v : neighbors[path[i]]) {
+                    const size_t j = local_index(v);
+                    if (j < length) {
+                        path_neighbors[i].push_back(j);
+                    }
+
+                    is_border = is_border || j >= length || close_to_endpoint(j);
+                }
+
+                if (is_border) {
+                    border.push_back(path[i]);
+                }
+            }
+
+            const auto get_path_distance = [&get_distance, &path, length](const size_t x,
+                                                                          const size_t y) {
+                if ((x == 0 && y == length - 1) || (x == length - 1 && y == 0)) {
+                    return fixed_edge_weight;
+                }
+
+                return get_distance(path[x], path[y]);
+            };
+
+            local_search::TwoOpt two_opt(get_path_distance, path_neighbors);
+            local_search::OrOpt or_opt(get_path_distance, path_neighbors);
+
+            // rewrite the path in circuit from node 0, walking away from node length - 1
+            const auto improve_tour = [&](auto& tour) {
+                std::vector<size_t> local_circuit(length);
+                std::iota(local_circuit.begin(), local_circuit.end(), 0);
+                tour.assign(local_circuit);
+
+                const int gain = optimize_tour(stage, two_opt, or_opt, tour);
+
+                const bool forward = tour.next(0) != length - 1;
+                size_t v = 0;
+                for (size_t i = 0; i < length; ++i) {
+                    const size_t index = first + i;
+                    circuit[index < size ? index : index - size] = path[v];
+                    v = forward ? tour.next(v) : tour.prev(v);
+                }
+
+                return gain;
+            };
+
+            if (length >= two_level_list_min_size) {
+                TwoLevelList tour(length);
+                return improve_tour(tour);
+            }
+
+            ArrayTour tour(length);
+            return improve_tour(tour);
+        }
+
+        /**
+         * Split circuit in n_fragments paths of about the same length, where the first one
+         * starts at circuit[offset], and improve every path on its own thread according to
+         * stage, keeping its endpoints fixed. Return the total decrease of the circuit weight.
+         * Every path is at least 4 nodes long. The nodes of the borders of the paths are stored
+         * in border, see improve_path.
+         */
+        template <class Distance>
+        [[nodiscard]] int improve_fragments(const Stage stage, const Distance& get_distance,
+                                            const std::vector<std::vector<size_t>>& neighbors,
+                                            std::vector<size_t>& circuit,
+                                            const size_t n_fragments, const size_t offset,
+                                            std::vector<size_t>& border) {
+            const size_t size = circuit.size();
+
+            std::vector<size_t> position(size);
+            for (size_t i = 0; i < size; ++i) {
+                position[circuit[i]] = i;
+            }
+
+            // every thread writes the gain and the border of its path, and its own nodes of
+            // circuit
+            std::vector<int> gains(n_fragments, 0);
+            std::vector<std::vector<size_t>> borders(n_fragments);
+            std::vector<std::thread> threads;
+            threads.reserve(n_fragments);
+
+            for (size_t f = 0; f < n_fragments; ++f) {
+                const size_t begin = size * f / n_fragments;
+                const size_t end = size * (f + 1) / n_fragments;
+                const size_t first = (offset + begin) % size;
+
+                threads.emplace_back([&, f, first, length = end - begin]() {
+                    gains[f] = improve_path(stage, get_distance, neighbors, position, circuit,
+                                            first, length, borders[f]);
+                });
+            }
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            border.clear();
+            for (const auto& fragment_border : borders) {
+                border.insert(border.end(), fragment_border.cbegin(), fragment_border.cend());
+            }
+
+            int total_gain = 0;
+            for (const int gain : gains) {
+                total_gain += gain;
+            }
+
+            return total_gain;
+        }
+    }  // namespace detail
+
+    /**
+     * Improve circuit according to stage and return its weight.
+     * The nearest neighbor lists are only computed if stage needs them.
+     * Circuits with at least parallel_min_size nodes are first improved in parallel: the
+     * circuit is split in 1 path per thread, and every path is improved on its own thread with
+     * its endpoints fixed. The circuit is then split again with the boundaries shifted by half a
+     * path, so that the moves across the previous boundaries are found in parallel too. A final
+     * sequential pass applies the few improving moves left, starting from the nodes close to
+     * the last boundaries only. The result is a different local optimum from the one of the
+     * sequential search: on 120000 points, it's from 0.2% lighter to 0.5% heavier, and the
+     * spread grows with the number of threads.
+     *
+     * @param stage the improvement stage to apply.
+     * @param get_distance function that returns the distance between any 2 nodes. It's called by
+     *                     several threads at once.
+     * @param make_neighbors function that returns the nearest neighbor lists of the graph, sorted
+     *                       by distance.
+     * @param circuit the Hamiltonian circuit to improve. It's updated in place.
+     * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core
+     *                      is used.
+     */
+    template <class Distance, class NeighborsFactory>
+    [[nodiscard]] int improve_circuit(const Stage stage, Distance&& get_distance,
+                                      NeighborsFactory&& make_neighbors,
+                                      std::vector<size_t>& circuit,
+                                      std::optional<size_t> n_workers_opt = {}) {
+        const size_t size = circuit.size();
+        int weight = utils::sum_weights_as_circuit(circuit.cbegin(), circuit.cend(), get_distance);
+
+        if (stage == Stage::none || size < 4) {
+            return weight;
+        }
+
+        // make_neighbors may either return the lists or a reference to lists computed earlier
+        const std::vector<std::vector<size_t>>& neighbors = make_neighbors();
+
+        // fallback on a single core if the system isn't able to detect the number of CPU cores
+        const size_t n_workers =
+            n_workers_opt.value_or(std::max(std::thread::hardware_concurrency(), 1U));
+        const size_t n_fragments = std::min(n_workers, size / min_fragment_size);
+
+        // nodes the sequential pass starts from, every node if it's null
+        std::vector<size_t> border;
+        const std::vector<size_t>* vertexes = nullptr;
+
+        if (size >= parallel_min_size && n_fragments > 1) {
+            weight -= detail::improve_fragments(stage, get_distance, neighbors, circuit,
+                                                n_fragments, 0, border);
+            weight -= detail::improve_fragments(stage, get_distance, neighbors, circuit,
+                                                n_fragments, size / n_fragments / 2, border);
+            vertexes = &border;
+        }
+
+        local_search::TwoOpt two_opt(get_distance, neighbors);
+        local_search::OrOpt or_opt(get_distance, neighbors);
+
+        // apply the local searches to tour, and return the total decrease of its weight
+        const auto improve_tour = [&](auto& tour) {
+            tour.assign(circuit);
+            const int gain = optimize_tour(stage, two_opt, or_opt, tour, vertexes);
+            tour.copy_to(circuit);
+            return gain;
+        };
+
+        if (size >= two_level_list_min_size) {
+            TwoLevelList tour(size);
+            return weight - improve_tour(tour);
+        }
+
+        ArrayTour tour(size);
+        return weight - improve_tour(tour);
+    }
+
+    // improve circuit of the graph represented by distance_matrix, and return its weight
+    [[nodiscard]] inline int improve_circuit(const Stage stage,
+                                             const DistanceMatrix<int>& distance_matrix,
+                                             std::vector<size_t>& circuit) {
+        // lambda function that returns the distance between any 2 nodes
+        const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+            return distance_matrix.at(x, y);
+        };
+
+        return improve_circuit(
+            stage, get_distance,
+            [&distance_matrix]() {
+                return neighbors::k_nearest_neighbors(distance_matrix, n_neighbors);
+            },
+            circuit);
+    }
+}  // namespace improvement
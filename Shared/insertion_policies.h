@@ -0,0 +1,398 @@
+#pragma once
+
+#include <algorithm>   // std::fill, std::min
+#include <cmath>       // std::floor
+#include <functional>  // std::less, std::greater
+#include <limits>      // std::numeric_limits
+#include <utility>     // std::pair
+#include <vector>      // std::vector
+
+#include "DistanceMatrix.h"
+#include "IndexedPriorityQueue.h"
+#include "LinkedTour.h"
+#include "VertexSet.h"
+#include "convex_hull.h"
+#include "point.h"
+#include "random_generator.h"
+
+/**
+ * Policies used to customize the insertion engine defined in insertion_tsp.h.
+ *
+ * A seeding policy is a functor that receives the distance matrix and returns the nodes of the
+ * initial partial Hamiltonian circuit, in order. Seeding policies that need the coordinates of the
+ * points receive them in their constructor.
+ *
+ * A selection policy is constructed with the distance matrix and must expose:
+ * - init(tour, not_visited): called after the initial partial circuit has been created. The same
+ *   policy may be used for several runs, so init must reset any state left by the previous run;
+ * - select(not_visited): return the next node k to add to the partial circuit;
+ * - position(k, tour): return the node i of the circuit such that k is inserted in between i and
+ *   tour.next(i);
+ * - on_insert(k, tour, not_visited): called after k has been added to the partial circuit.
+ *
+ * Every policy is resolved at compile time, so there's no virtual dispatch in the engine loop.
+ */
+namespace insertion {
+    namespace detail {
+        // return the cost of inserting k in between the consecutive tour cities i and j
+        [[nodiscard]] inline int insertion_cost(const DistanceMatrix<int>& distance_matrix,
+                                                const size_t i, const size_t k,
+                                                const size_t j) noexcept {
+            return distance_matrix.at(i, k) + distance_matrix.at(k, j) - distance_matrix.at(i, j);
+        }
+
+        // find the arc (i, j) that minimizes the value of w(i, k) + w(k, j) - w(i, j).
+        // Return i and the insertion cost.
+        // Time: O(n), where n is the size of the partial circuit
+        [[nodiscard]] inline std::pair<size_t, int> best_insertion(
+            const DistanceMatrix<int>& distance_matrix, const size_t k,
+            const LinkedTour& tour) noexcept {
+            int min_cost = std::numeric_limits<int>::max();
+            size_t min_i = tour.front();
+
+            tour.for_each_arc([&](const size_t i, const size_t j) {
+                const int cost = insertion_cost(distance_matrix, i, k, j);
+                if (cost < min_cost) {
+                    min_cost = cost;
+                    min_i = i;
+                }
+            });
+
+            return {min_i, min_cost};
+        }
+
+        /**
+         * Keep track of δ(k, circuit), the minimum distance between each node k not in the
+         * partial circuit and the nodes in the circuit, as well as the circuit node that realizes
+         * it. Every insertion updates it in O(n), instead of recomputing it in O(n^2).
+         */
+        class distance_to_circuit {
+        protected:
+            const DistanceMatrix<int>& distance_matrix;
+
+            // delta[k] = δ(k, circuit)
+            std::vector<int> delta;
+
+            // closest[k] is the node h in circuit that minimizes w(h, k)
+            std::vector<size_t> closest;
+
+        public:
+            explicit distance_to_circuit(const DistanceMatrix<int>& distance_matrix) :
+                distance_matrix(distance_matrix),
+                delta(distance_matrix.size(), std::numeric_limits<int>::max()),
+                closest(distance_matrix.size()) {
+            }
+
+            void init(const LinkedTour& tour, const VertexSet& not_visited) noexcept {
+                std::fill(delta.begin(), delta.end(), std::numeric_limits<int>::max());
+                tour.for_each_arc([&](const size_t h, size_t) {
+                    on_insert(h, tour, not_visited);
+                });
+            }
+
+            void on_insert(const size_t k, const LinkedTour&,
+                           const VertexSet& not_visited) noexcept {
+                for (const size_t u : not_visited) {
+                    const int weight = distance_matrix.at(k, u);
+                    if (weight < delta[u]) {
+                        delta[u] = weight;
+                        closest[u] = k;
+                    }
+                }
+            }
+        };
+    }  // namespace detail
+
+    /**
+     * Seeding policy: start from the node returned by rand_int and add the node closest to it.
+     */
+    class seed_random_closest {
+        random_generator::RandomGenerator<size_t>& rand_int;
+
+    public:
+        explicit seed_random_closest(random_generator::RandomGenerator<size_t>& rand_int) noexcept :
+            rand_int(rand_int) {
+        }
+
+        [[nodiscard]] std::vector<size_t> operator()(const DistanceMatrix<int>& distance_matrix) {
+            const size_t first_node = rand_int();
+            const size_t second_node = distance_matrix.get_closest_node(first_node);
+            return {first_node, second_node};
+        }
+    };
+
+    /**
+     * Seeding policy: start from the 2 farthest nodes in the graph.
+     */
+    struct seed_farthest_pair {
+        [[nodiscard]] std::vector<size_t> operator()(const DistanceMatrix<int>& distance_matrix) {
+            const auto [first_node, second_node] = distance_matrix.get_2_farthest_nodes();
+            return {first_node, second_node};
+        }
+    };
+
+    /**
+     * Seeding policy: start from the convex hull of the points, in counter-clockwise order.
+     * In the Euclidean plane, the hull nodes are visited in the same order by the optimal tour,
+     * and starting from them saves as many insertions as the number of hull nodes.
+     * Time: O(n log n)
+     */
+    class seed_convex_hull {
+        const std::vector<point::point_2D>& points;
+
+    public:
+        explicit seed_convex_hull(const std::vector<point::point_2D>& points) noexcept :
+            points(points) {
+        }
+
+        [[nodiscard]] std::vector<size_t> operator()(const DistanceMatrix<int>&) const {
+            return geometry::convex_hull(points);
+        }
+    };
+
+    /**
+     * Selection policy: select the node k that minimizes (Compare = std::less<>) or maximizes
+     * (Compare = std::greater<>) δ(k, circuit), and insert it where the circuit weight increases
+     * the least.
+     */
+    template <typename Compare>
+    class select_by_distance : public detail::distance_to_circuit {
+        Compare comp;
+
+    public:
+        using detail::distance_to_circuit::distance_to_circuit;
+
+        [[nodiscard]] size_t select(const VertexSet& not_visited) const noexcept {
+            size_t new_k = not_visited[0];
+            for (const size_t k : not_visited) {
+                if (comp(delta[k], delta[new_k])) {
+                    new_k = k;
+                }
+            }
+
+            return new_k;
+        }
+
+        [[nodiscard]] size_t position(const size_t k, const LinkedTour& tour) const noexcept {
+            return detail::best_insertion(distance_matrix, k, tour).first;
+        }
+    };
+
+    // Closest Insertion: select the node k not in circuit that minimizes δ(k, circuit)
+    using select_closest = select_by_distance<std::less<>>;
+
+    // Farthest Insertion: select the node k not in circuit that maximizes δ(k, circuit)
+    using select_farthest = select_by_distance<std::greater<>>;
+
+    /**
+     * Randomized version of select_by_distance used by GRASP: the restricted candidate list
+     * (RCL) contains every node k not in circuit whose δ(k, circuit) is within alpha of the best
+     * value, i.e. comp(δ(k, circuit), threshold) or δ(k, circuit) == threshold, where
+     * threshold = best + alpha * (worst - best). A node of the RCL is selected uniformly at random
+     * and inserted where the circuit weight increases the least.
+     * With alpha = 0 the policy is as greedy as select_by_distance, with alpha = 1 it's the same
+     * as select_random. Every instance owns its random generator.
+     */
+    template <typename Compare>
+    class select_by_distance_rcl : public detail::distance_to_circuit {
+        Compare comp;
+
+        // greediness of the selection, in [0, 1]
+        double alpha;
+
+        // real number generator in the range [0, 1)
+        random_generator::RealRandomGenerator random{0.0, 1.0};
+
+    public:
+        select_by_distance_rcl(const DistanceMatrix<int>& distance_matrix, const double alpha) :
+            detail::distance_to_circuit(distance_matrix), alpha(alpha) {
+        }
+
+        // Time: O(n), with 2 scans of not_visited
+        [[nodiscard]] size_t select(const VertexSet& not_visited) {
+            int best = delta[not_visited[0]];
+            int worst = best;
+            for (const size_t k : not_visited) {
+                if (comp(delta[k], best)) {
+                    best = delta[k];
+                }
+                if (comp(worst, delta[k])) {
+                    worst = delta[k];
+                }
+            }
+
+            const double threshold = best + alpha * (static_cast<double>(worst) - best);
+            const auto in_rcl = [&](const size_t k) {
+                return !comp(threshold, static_cast<double>(delta[k]));
+            };
+
+            size_t rcl_size = 0;
+            for (const size_t k : not_visited) {
+                rcl_size += in_rcl(k) ? 1 : 0;
+            }
+
+            // random() may return exactly 1.0
+            const auto rank = std::min(static_cast<size_t>(random() * rcl_size), rcl_size - 1);
+
+            size_t count = 0;
+            for (const size_t k : not_visited) {
+                if (in_rcl(k) && count++ == rank) {
+                    return k;
+                }
+            }
+
+            return not_visited[0];
+        }
+
+        [[nodiscard]] size_t position(const size_t k, const LinkedTour& tour) const noexcept {
+            return detail::best_insertion(distance_matrix, k, tour).first;
+        }
+    };
+
+    // GRASP version of Closest Insertion
+    using select_closest_rcl = select_by_distance_rcl<std::less<>>;
+
+    // GRASP version of Farthest Insertion
+    using select_farthest_rcl = select_by_distance_rcl<std::greater<>>;
+
+    /**
+     * Selection policy used by Nearest Insertion: select the node k not in circuit that minimizes
+     * δ(k, circuit), and insert it next to its closest node h in the circuit, either before or
+     * after h, whatever increases the circuit weight the least.
+     * Unlike Closest Insertion, the insertion point is found in O(1).
+     */
+    class select_nearest : public detail::distance_to_circuit {
+    public:
+        using detail::distance_to_circuit::distance_to_circuit;
+
+        [[nodiscard]] size_t select(const VertexSet& not_visited) const noexcept {
+            size_t new_k = not_visited[0];
+            for (const size_t k : not_visited) {
+                if (delta[k] < delta[new_k]) {
+                    new_k = k;
+                }
+            }
+
+            return new_k;
+        }
+
+        [[nodiscard]] size_t position(const size_t k, const LinkedTour& tour) const noexcept {
+            const size_t h = closest[k];
+            const size_t prev = tour.prev(h);
+            const size_t next = tour.next(h);
+
+            const int cost_before = detail::insertion_cost(distance_matrix, prev, k, h);
+            const int cost_after = detail::insertion_cost(distance_matrix, h, k, next);
+
+            return cost_before < cost_after ? prev : h;
+        }
+    };
+
+    /**
+     * Selection policy used by Random Insertion: select a random node k not in circuit, and
+     * insert it where the circuit weight increases the least.
+     * Every instance owns its random generator.
+     */
+    class select_random {
+        const DistanceMatrix<int>& distance_matrix;
+
+        // real number generator in the range [0, 1)
+        random_generator::RealRandomGenerator random{0.0, 1.0};
+
+    public:
+        explicit select_random(const DistanceMatrix<int>& distance_matrix) :
+            distance_matrix(distance_matrix) {
+        }
+
+        void init(const LinkedTour&, const VertexSet&) noexcept {
+        }
+
+        void on_insert(size_t, const LinkedTour&, const VertexSet&) noexcept {
+        }
+
+        [[nodiscard]] size_t select(const VertexSet& not_visited) {
+            const size_t size = not_visited.size();
+            const auto index = static_cast<size_t>(std::floor(random() * size));
+
+            // random() may return exactly 1.0
+            return not_visited[index < size ? index : size - 1];
+        }
+
+        [[nodiscard]] size_t position(const size_t k, const LinkedTour& tour) const noexcept {
+            return detail::best_insertion(distance_matrix, k, tour).first;
+        }
+    };
+
+    /**
+     * Selection policy used by Cheapest Insertion: select the node k not in circuit and the arc
+     * (i, j) that minimize w(i, k) + w(k, j) - w(i, j), and insert k in between i and j.
+     * Every node not in circuit keeps its best insertion arc and cost in an indexed Min Heap.
+     * After an arc (i, j) is split by k, only the nodes whose best arc was (i, j) are scanned
+     * again, while every other node is compared against the new arcs (i, k) and (k, j).
+     * Time: O(n log n + k n) per insertion, where k is the number of nodes whose best arc was
+     *       split. On uniform random points k grows about like sqrt(n) (about 35 at n = 1000, 69
+     *       at n = 4000), i.e. O(n^2.5) overall. If a constant fraction of the nodes shares the
+     *       split arc, e.g. when the distances have many ties, the worst case is O(n^3).
+     */
+    class select_cheapest {
+        const DistanceMatrix<int>& distance_matrix;
+
+        // best_from[k] is the first endpoint of the arc (i, tour.next(i)) where the insertion of
+        // the not visited node k costs the least
+        std::vector<size_t> best_from;
+
+        // keep track of the nodes not in the partial Hamiltonian circuit, sorted by the cost of
+        // their best insertion
+        priority_queue::IndexedPriorityQueue<int, std::less<>> min_pq;
+
+    public:
+        explicit select_cheapest(const DistanceMatrix<int>& distance_matrix) :
+            distance_matrix(distance_matrix),
+            best_from(distance_matrix.size()),
+            min_pq(priority_queue::make_min_indexed_priority_queue<int>(distance_matrix.size())) {
+        }
+
+        void init(const LinkedTour& tour, const VertexSet& not_visited) {
+            min_pq.clear();
+            for (const size_t u : not_visited) {
+                const auto [i, cost] = detail::best_insertion(distance_matrix, u, tour);
+                best_from[u] = i;
+                min_pq.push(cost, u);
+            }
+        }
+
+        [[nodiscard]] size_t select(const VertexSet&) const noexcept {
+            return min_pq.top();
+        }
+
+        [[nodiscard]] size_t position(const size_t k, const LinkedTour&) const noexcept {
+            return best_from[k];
+        }
+
+        void on_insert(const size_t k, const LinkedTour& tour, const VertexSet& not_visited) {
+            min_pq.erase(k);
+
+            // the arc (i, j) has been split in (i, k) and (k, j)
+            const size_t i = tour.prev(k);
+            const size_t j = tour.next(k);
+
+            for (const size_t u : not_visited) {
+                if (best_from[u] == i) {
+                    const auto [new_i, cost] = detail::best_insertion(distance_matrix, u, tour);
+                    best_from[u] = new_i;
+                    min_pq.update_key(cost, u);
+                    continue;
+                }
+
+                const int cost_ik = detail::insertion_cost(distance_matrix, i, u, k);
+                const int cost_kj = detail::insertion_cost(distance_matrix, k, u, j);
+                const int min_cost = std::min(cost_ik, cost_kj);
+
+                if (min_cost < min_pq.key_at(u)) {
+                    best_from[u] = cost_ik <= cost_kj ? i : k;
+                    min_pq.update_key(min_cost, u);
+                }
+            }
+        }
+    };
+}  // namespace insertion
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <limits>    // std::numeric_limits
+#include <optional>  // std::optional
+#include <utility>   // std::forward
+#include <vector>    // std::vector
+
+#include "DistanceMatrix.h"
+#include "LinkedTour.h"
+#include "VertexSet.h"
+#include "improvement.h"
+#include "insertion_policies.h"
+#include "shared_utils.h"
+
+namespace insertion {
+    /**
+     * Insertion engine that owns the partial circuit, the set of nodes not in circuit and the
+     * selection policy, so that several insertion runs on the same graph reuse the memory
+     * allocated by the first one. Every run completes the partial circuit given by its seeds.
+     */
+    template <class Selection>
+    class InsertionEngine {
+        const DistanceMatrix<int>& distance_matrix;
+
+        // partial Hamiltonian circuit
+        LinkedTour tour;
+
+        // keep track of the nodes not in the partial Hamiltonian circuit
+        VertexSet not_visited;
+
+        Selection selection;
+
+    public:
+        /**
+         * @param distance_matrix represents the graph as a Distance Matrix.
+         * @param selection_args additional arguments forwarded to the selection policy.
+         */
+        template <class... SelectionArgs>
+        explicit InsertionEngine(const DistanceMatrix<int>& distance_matrix,
+                                 SelectionArgs&&... selection_args) :
+            distance_matrix(distance_matrix),
+            tour(distance_matrix.size()),
+            not_visited(distance_matrix.size()),
+            selection(distance_matrix, std::forward<SelectionArgs>(selection_args)...) {
+        }
+
+        /**
+         * Complete the partial circuit that visits seeds in order.
+         * The weight of the partial circuit is updated after every insertion, and the run is
+         * abandoned as soon as it reaches bound(). Return the weight of the circuit found, or
+         * std::nullopt if the run has been abandoned.
+         */
+        template <class Bound>
+        [[nodiscard]] std::optional<int> run(const std::vector<size_t>& seeds, Bound&& bound) {
+            // lambda function that returns the distance between any 2 nodes
+            const auto get_distance = [this](const size_t x, const size_t y) {
+                return distance_matrix.at(x, y);
+            };
+
+            // Step 1: create the initial partial Hamiltonian circuit
+            tour.assign(seeds);
+            int circuit_weight =
+                utils::sum_weights_as_circuit(seeds.cbegin(), seeds.cend(), get_distance);
+
+            not_visited.fill();
+            for (const size_t h : seeds) {
+                not_visited.erase(h);
+            }
+
+            selection.init(tour, not_visited);
+
+            // Step 2: repeat the insertion until all nodes have been inserted into the circuit
+            while (!not_visited.empty()) {
+                // in the Metric-TSP the weight of the partial circuit never decreases, so this
+                // run can't improve the bound anymore
+                if (circuit_weight >= bound()) {
+                    return std::nullopt;
+                }
+
+                // select the not visited node k according to the selection policy
+                const size_t k = selection.select(not_visited);
+                not_visited.erase(k);
+
+                // insert k in the partial circuit according to the selection policy
+                const size_t i = selection.position(k, tour);
+                circuit_weight += detail::insertion_cost(distance_matrix, i, k, tour.next(i));
+                tour.insert_after(i, k);
+
+                selection.on_insert(k, tour, not_visited);
+            }
+
+            return circuit_weight;
+        }
+
+        // return the circuit built by the last run
+        [[nodiscard]] const LinkedTour& get_tour() const noexcept {
+            return tour;
+        }
+    };
+
+    /**
+     * Generic insertion heuristic for the Metric-TSP. Closest, Farthest, Random and Nearest
+     * Insertion only differ in how the initial partial circuit is created (Seeding) and in how
+     * the next node and its insertion point are chosen (Selection). See insertion_policies.h.
+     * The partial circuit is a LinkedTour, so every insertion takes O(1).
+     * The circuit built is then improved according to stage, see improvement.h.
+     * Time: O(n^2) with the Closest, Farthest, Random and Nearest policies, O(n^2 log n) with the
+     * Cheapest policy.
+     *
+     * @param distance_matrix represents the graph as a Distance Matrix.
+     * @param seeding functor that returns the initial partial Hamiltonian circuit.
+     * @param stage optional improvement stage applied to the circuit built.
+     */
+    template <class Selection, class Seeding>
+    [[nodiscard]] int insertion_tsp(DistanceMatrix<int>& distance_matrix, Seeding&& seeding,
+                                    const improvement::Stage stage = improvement::Stage::none) {
+        const auto unbounded = []() noexcept {
+            return std::numeric_limits<int>::max();
+        };
+
+        const std::vector<size_t> seeds(std::forward<Seeding>(seeding)(distance_matrix));
+        InsertionEngine<Selection> engine(distance_matrix);
+        const int circuit_weight = *engine.run(seeds, unbounded);
+
+        if (stage == improvement::Stage::none) {
+            return circuit_weight;
+        }
+
+        std::vector<size_t> circuit(engine.get_tour().to_vector());
+        return improvement::improve_circuit(stage, distance_matrix, circuit);
+    }
+}  // namespace insertion
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>  // std::min, std::sort
+#include <array>      // std::array
+#include <utility>    // std::move, std::pair
+#include <vector>     // std::vector
+
+#include "DontLookBits.h"
+#include "double_bridge.h"
+#include "random_generator.h"
+
+namespace local_search {
+    /**
+     * Lin-Kernighan style variable depth local search restricted to candidate lists, with
+     * don't-look bits.
+     * A move starts by removing a tour edge (t1, t2). At every step, the free end t2 is linked to
+     * a candidate t3, and the tour edge (t4, t3) that keeps the tour a Hamiltonian circuit when
+     * (t4, t1) closes it is removed, so the tour is always valid and the step is a 2-opt flip.
+     * The chain of flips goes on while the gain of the edges removed minus the edges added is
+     * positive, and it's applied as soon as closing it improves the tour. Otherwise, the flips
+     * are undone. An edge added by the chain is never removed by it, and vice versa.
+     * The first levels of the chain try several candidates: the chains of 2 flips, which are
+     * sequential 3-opt moves, are tried exhaustively over the candidate lists, and the chains of
+     * 4 flips, which are sequential 5-opt moves, with a smaller breadth. The deeper levels only
+     * follow the most promising candidate.
+     * Every edge exchange is recorded, so a trial made of a kick and the local search that
+     * follows it can be undone in time proportional to the exchanges it made.
+     * The object owns its workspace, so it can optimize many tours without allocating memory.
+     */
+    template <class Distance>
+    class LinKernighan {
+        // number of alternatives tried at the first levels of the chain
+        static constexpr std::array<size_t, 4> breadth = {5, 5, 3, 2};
+
+        // maximum number of flips of a move
+        static constexpr size_t max_depth = 50;
+
+        // maximum number of vertexes of the segments swapped by the double bridge kick
+        static constexpr size_t max_kick_segment_length = 50;
+
+        // the tour edges (a, b) and (c, d) replaced by (a, c) and (b, d), see
+        // ArrayTour::exchange and TwoLevelList::exchange
+        struct exchange_t {
+            size_t a;
+            size_t b;
+            size_t c;
+            size_t d;
+        };
+
+        // a possible step of the chain
+        struct alternative_t {
+            size_t t3;
+            size_t t4;
+            int score;
+        };
+
+        using edge_t = std::pair<size_t, size_t>;
+
+        // function that returns the distance between any 2 nodes
+        Distance get_distance;
+
+        // candidates[v] are the candidates of v, best ones first
+        const std::vector<std::vector<size_t>>& candidates;
+
+        // vertexes still to scan
+        DontLookBits active;
+
+        // exchanges made since the last call to optimize or trial
+        std::vector<exchange_t> journal;
+
+        // edges added and removed by the current chain
+        std::vector<edge_t> added;
+        std::vector<edge_t> removed;
+
+        // alternatives[level] are the steps tried at the given level of the chain
+        std::vector<std::vector<alternative_t>> alternatives;
+
+        // random generators of the kick
+        random_generator::IntegerRandomGenerator rand_vertex;
+        random_generator::IntegerRandomGenerator rand_length;
+
+        // return true iff the edge (x, y) is in edges
+        [[nodiscard]] static bool contains(const std::vector<edge_t>& edges, const size_t x,
+                                           const size_t y) noexcept {
+            for (const auto& [u, v] : edges) {
+                if ((u == x && v == y) || (u == y && v == x)) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // apply the exchange to tour and record it
+        template <class Tour>
+        void exchange(Tour& tour, const size_t a, const size_t b, const size_t c,
+                      const size_t d) {
+            tour.exchange(a, b, c, d);
+            journal.push_back({a, b, c, d});
+        }
+
+        // undo the exchanges recorded after the first mark ones
+        template <class Tour>
+        void undo_to(Tour& tour, const size_t mark) noexcept {
+            while (journal.size() > mark) {
+                // a c .. b d -> a b .. c d
+                const auto [a, b, c, d] = journal.back();
+                tour.exchange(a, c, b, d);
+                journal.pop_back();
+            }
+        }
+
+        /**
+         * Extend the chain whose tour edge (t1, t2) is the next one to remove, where gain is the
+         * weight of the edges removed minus the edges added so far. If an improving move is
+         * found, keep it and return its gain, otherwise restore the tour and return 0.
+         */
+        template <class Tour>
+        [[nodiscard]] int step(Tour& tour, const size_t level, const size_t t1,
+                               const size_t t2, const int gain) {
+            const bool forward = tour.next(t1) == t2;
+            auto& level_alternatives = alternatives[level];
+            level_alternatives.clear();
+
+            for (const size_t t3 : candidates[t2]) {
+                const int g1 = gain - get_distance(t2, t3);
+                if (g1 <= 0 || t3 == t1) {
+                    continue;
+                }
+
+                // t4 precedes t3 in the direction that goes from t1 to t2
+                const size_t t4 = forward ? tour.prev(t3) : tour.next(t3);
+                if (t4 == t2 || contains(removed, t2, t3) || contains(added, t3, t4)) {
+                    continue;
+                }
+
+                const int score = get_distance(t3, t4) - get_distance(t2, t3);
+                level_alternatives.push_back({t3, t4, score});
+            }
+
+            std::sort(level_alternatives.begin(), level_alternatives.end(),
+                      [](const auto& x, const auto& y) {
+                          return x.score > y.score;
+                      });
+
+            const size_t level_breadth = level < breadth.size() ? breadth[level] : 1;
+            const size_t n_alternatives = std::min(level_breadth, level_alternatives.size());
+
+            for (size_t i = 0; i < n_alternatives; ++i) {
+                const auto [t3, t4, score] = level_alternatives[i];
+                const size_t mark = journal.size();
+
+                // t1 t2 .. t4 t3 -> t1 t4 .. t2 t3
+                exchange(tour, t1, t2, t4, t3);
+                added.emplace_back(t2, t3);
+                removed.emplace_back(t4, t3);
+
+                const int chain_gain = gain + score;
+                const int closed_gain = chain_gain - get_distance(t4, t1);
+                if (closed_gain > 0) {
+                    return closed_gain;
+                }
+
+                if (level + 1 < max_depth) {
+                    const int deeper_gain = step(tour, level + 1, t1, t4, chain_gain);
+                    if (deeper_gain > 0) {
+                        return deeper_gain;
+                    }
+                }
+
+                undo_to(tour, mark);
+                added.pop_back();
+                removed.pop_back();
+            }
+
+            return 0;
+        }
+
+        // try the moves that start by removing a tour edge incident to t1. If an improving move
+        // is found, apply it and return its gain, otherwise return 0.
+        template <class Tour>
+        [[nodiscard]] int improve_from(Tour& tour, const size_t t1) {
+            // the orientation of the tour may change even if no move is applied
+            const std::array<size_t, 2> tour_neighbors = {tour.next(t1), tour.prev(t1)};
+
+            for (const size_t t2 : tour_neighbors) {
+                const size_t mark = journal.size();
+                added.clear();
+                removed.clear();
+                removed.emplace_back(t1, t2);
+
+                const int gain = step(tour, 0, t1, t2, get_distance(t1, t2));
+                if (gain > 0) {
+                    // the endpoints of every edge changed by the move are enqueued again
+                    active.push(t1);
+                    for (size_t i = mark; i < journal.size(); ++i) {
+                        const auto [a, b, c, d] = journal[i];
+                        for (const size_t v : {a, b, c, d}) {
+                            active.push(v);
+                        }
+                    }
+
+                    return gain;
+                }
+            }
+
+            return 0;
+        }
+
+        // apply improving moves starting from the active vertexes until none is left
+        template <class Tour>
+        [[nodiscard]] int run(Tour& tour) {
+            int total_gain = 0;
+            while (!active.empty()) {
+                total_gain += improve_from(tour, active.pop());
+            }
+
+            return total_gain;
+        }
+
+    public:
+        /**
+         * @param get_distance function that returns the distance between any 2 vertexes.
+         * @param candidates candidate lists of every vertex, best ones first. See
+         *                   alpha_nearness::alpha_nearest_neighbors.
+         */
+        LinKernighan(Distance get_distance, const std::vector<std::vector<size_t>>& candidates) :
+            get_distance(std::move(get_distance)),
+            candidates(candidates),
+            active(candidates.size()),
+            alternatives(max_depth),
+            rand_vertex(0, candidates.empty() ? 0 : candidates.size() - 1),
+            rand_length(1, std::max<size_t>(std::min(max_kick_segment_length,
+                                                     candidates.size() / 2 - 1),
+                                            1)) {
+            added.reserve(max_depth + 1);
+            removed.reserve(max_depth + 1);
+            for (auto& level_alternatives : alternatives) {
+                level_alternatives.reserve(candidates.empty() ? 0 : candidates[0].size());
+            }
+        }
+
+        /**
+         * Apply improving moves to tour until none is left, i.e. until tour is a local optimum
+         * with respect to the candidate lists. Return the total decrease of the tour weight.
+         * Tour is either an ArrayTour or a TwoLevelList.
+         * Time: O(n k^2) per pass over the vertexes for the first 2 levels of the chains, where
+         *       k is the number of candidates, plus the cost of the deeper levels and of the
+         *       reversals.
+         */
+        template <class Tour>
+        int optimize(Tour& tour) {
+            journal.clear();
+            active.reset_tour(tour);
+            return run(tour);
+        }
+
+        /**
+         * Apply a double bridge kick to tour, which swaps 2 random consecutive segments of at
+         * most max_kick_segment_length vertexes, then optimize tour again starting from the
+         * endpoints of the edges changed. The tour must have at least 8 vertexes.
+         * Return the decrease of the tour weight, which is negative if the trial made the tour
+         * worse. The trial can be undone with undo_trial.
+         * Time: O(max_kick_segment_length) for the kick, plus the local search.
+         */
+        template <class Tour>
+        [[nodiscard]] int trial(Tour& tour) {
+            journal.clear();
+
+            const auto kick =
+                double_bridge_t::after(tour, rand_vertex(), rand_length(), rand_length());
+            kick.apply([this, &tour](const size_t a, const size_t b, const size_t c,
+                                     const size_t d) {
+                exchange(tour, a, b, c, d);
+            });
+
+            active.reset(kick.endpoints());
+            const int kick_gain = kick.gain(get_distance);
+            return kick_gain + run(tour);
+        }
+
+        // restore the tour as it was before the last trial
+        template <class Tour>
+        void undo_trial(Tour& tour) noexcept {
+            undo_to(tour, 0);
+        }
+    };
+}  // namespace local_search
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>  // std::clamp, std::min, std::shuffle
+#include <atomic>     // std::atomic
+#include <limits>     // std::numeric_limits
+#include <numeric>    // std::iota
+#include <optional>   // std::optional
+#include <random>     // std::mt19937, std::random_device
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "improvement.h"
+#include "insertion_tsp.h"
+#include "nearest_neighbors.h"
+#include "parallel_executor.h"
+#include "shared_utils.h"
+
+namespace insertion {
+    /**
+     * Multi-start insertion heuristic: run the insertion heuristic defined by Selection from
+     * n_starts distinct start nodes, each one seeded as in seed_random_closest, and return the
+     * best cost found.
+     * The start nodes are a random sample without repetitions of the nodes in the graph. They
+     * are pulled by the worker threads from a shared atomic counter, and every worker owns its
+     * insertion engine, so no state but the counter and the best cost is shared.
+     * The best cost found so far is an atomic bound: every run is abandoned as soon as its
+     * partial circuit weighs at least as much as the best complete circuit. The runs that
+     * complete are improved according to stage, see improvement.h.
+     *
+     * @param distance_matrix represents the graph as a Distance Matrix.
+     * @param n_starts number of distinct start nodes. It's clamped to [1, n].
+     * @param stage optional improvement stage applied to every circuit completed.
+     * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core
+     *                      is used.
+     */
+    template <class Selection>
+    [[nodiscard]] int multi_start_insertion_tsp(
+        DistanceMatrix<int>& distance_matrix, const size_t n_starts,
+        const improvement::Stage stage = improvement::Stage::none,
+        std::optional<size_t>&& n_workers_opt = {}) {
+        const size_t size = distance_matrix.size();
+        const size_t n_runs = std::clamp<size_t>(n_starts, 1, size);
+
+        // lambda function that returns the distance between any 2 nodes
+        const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+            return distance_matrix.at(x, y);
+        };
+
+        // sample n_runs distinct start nodes
+        std::vector<size_t> start_nodes(size);
+        std::iota(start_nodes.begin(), start_nodes.end(), 0);
+        std::shuffle(start_nodes.begin(), start_nodes.end(), std::mt19937{std::random_device()()});
+        start_nodes.resize(n_runs);
+
+        // the nearest neighbor lists are shared by the improvement stage of every run
+        std::vector<std::vector<size_t>> neighbors;
+        if (stage != improvement::Stage::none) {
+            neighbors = neighbors::k_nearest_neighbors(distance_matrix, improvement::n_neighbors);
+        }
+
+        // index of the next start node to run
+        std::atomic<size_t> next_run{0};
+
+        // weight of the best complete circuit built so far
+        std::atomic<int> best_bound{std::numeric_limits<int>::max()};
+
+        const auto bound = [&best_bound]() noexcept {
+            return best_bound.load(std::memory_order_relaxed);
+        };
+
+        auto worker = [&]() {
+            InsertionEngine<Selection> engine(distance_matrix);
+            std::vector<size_t> seeds(2);
+            std::vector<size_t> circuit;
+            int best_cost = std::numeric_limits<int>::max();
+
+            for (size_t run = next_run++; run < n_runs; run = next_run++) {
+                seeds[0] = start_nodes[run];
+                seeds[1] = distance_matrix.get_closest_node(seeds[0]);
+
+                const auto circuit_weight = engine.run(seeds, bound);
+                if (!circuit_weight.has_value()) {
+                    continue;
+                }
+
+                // lower best_bound to circuit_weight, unless another thread has already built a
+                // better circuit
+                int best = best_bound.load();
+                while (*circuit_weight < best &&
+                       !best_bound.compare_exchange_weak(best, *circuit_weight)) {
+                }
+
+                int cost = *circuit_weight;
+                if (stage != improvement::Stage::none) {
+                    engine.get_tour().copy_to(circuit, seeds[0]);
+                    cost = improvement::improve_circuit(
+                        stage, get_distance,
+                        [&neighbors]() -> const auto& {
+                            return neighbors;
+                        },
+                        circuit);
+                }
+
+                best_cost = std::min(best_cost, cost);
+            }
+
+            return best_cost;
+        };
+
+        const auto executor(executor::parallel_executor(std::move(n_workers_opt),
+                                                        std::move(worker)));
+
+        return executor.get_best_result(utils::min_element);
+    }
+}  // namespace insertion
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>  // std::min, std::nth_element, std::partial_sort
+#include <numeric>    // std::iota
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "SpatialGrid.h"
+#include "point.h"
+
+namespace neighbors {
+    /**
+     * Return the candidate lists of the graph: for every node v, the k nodes closest to v,
+     * sorted by distance from v. v itself is never in its own list.
+     * Time: O(n^2 log k)
+     *
+     * @param distance_matrix represents the graph as a Distance Matrix.
+     * @param k number of neighbors of each node. It's clamped to n - 1.
+     */
+    [[nodiscard]] inline std::vector<std::vector<size_t>> k_nearest_neighbors(
+        const DistanceMatrix<int>& distance_matrix, const size_t k) {
+        const size_t size = distance_matrix.size();
+        const size_t n_neighbors = size > 0 ? std::min(k, size - 1) : 0;
+
+        std::vector<std::vector<size_t>> neighbors(size);
+        std::vector<size_t> others(size > 0 ? size - 1 : 0);
+
+        for (size_t v = 0; v < size; ++v) {
+            // every node but v
+            std::iota(others.begin(), others.begin() + v, 0);
+            std::iota(others.begin() + v, others.end(), v + 1);
+
+            const auto by_distance = [&distance_matrix, v](const size_t x, const size_t y) {
+                return distance_matrix.at(v, x) < distance_matrix.at(v, y);
+            };
+
+            std::partial_sort(others.begin(), others.begin() + n_neighbors, others.end(),
+                              by_distance);
+            neighbors[v].assign(others.cbegin(), others.cbegin() + n_neighbors);
+        }
+
+        return neighbors;
+    }
+
+    /**
+     * Return the candidate lists of the points on the plane: for every point v, the k points
+     * closest to v in Euclidean distance, sorted by distance from v. v itself is never in its
+     * own list. The points are indexed by a SpatialGrid, and the rings of cells around v are
+     * visited until the k-th closest point found so far is closer than any cell not visited yet.
+     * Time: O(nk log k) on uniformly distributed points.
+     *
+     * @param points the points on the plane.
+     * @param k number of neighbors of each point. It's clamped to n - 1.
+     */
+    [[nodiscard]] inline std::vector<std::vector<size_t>> k_nearest_neighbors(
+        const std::vector<point::point_2D>& points, const size_t k) {
+        const size_t size = points.size();
+        const size_t n_neighbors = size > 0 ? std::min(k, size - 1) : 0;
+
+        const SpatialGrid grid(points);
+        std::vector<std::vector<size_t>> neighbors(size);
+        std::vector<size_t> candidates;
+
+        for (size_t v = 0; v < size; ++v) {
+            const auto squared_distance = [&points, v](const size_t u) {
+                const double dx = points[u].x - points[v].x;
+                const double dy = points[u].y - points[v].y;
+                return dx * dx + dy * dy;
+            };
+
+            const auto by_distance = [&squared_distance](const size_t x, const size_t y) {
+                return squared_distance(x) < squared_distance(y);
+            };
+
+            candidates.clear();
+            for (size_t ring = 0; !grid.is_past_grid(points[v], ring); ++ring) {
+                grid.for_each_in_ring(points[v], ring, [&](const size_t u) {
+                    if (u != v) {
+                        candidates.push_back(u);
+                    }
+                });
+
+                if (candidates.size() < n_neighbors || n_neighbors == 0) {
+                    continue;
+                }
+
+                // the points in the cells after this ring are at least ring * cell_size away
+                const auto kth = candidates.begin() + (n_neighbors - 1);
+                std::nth_element(candidates.begin(), kth, candidates.end(), by_distance);
+
+                const double bound = ring * grid.get_cell_size();
+                if (squared_distance(*kth) <= bound * bound) {
+                    break;
+                }
+            }
+
+            std::partial_sort(candidates.begin(), candidates.begin() + n_neighbors,
+                              candidates.end(), by_distance);
+            neighbors[v].assign(candidates.cbegin(), candidates.cbegin() + n_neighbors);
+        }
+
+        return neighbors;
+    }
+}  // namespace neighbors
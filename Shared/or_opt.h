@@ -0,0 +1,210 @@
+#pragma once
+
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+#include "DontLookBits.h"
+
+namespace local_search {
+    /**
+     * Move the segment s1 -> ... -> s2 of tour, currently in between prev and next, in between
+     * the consecutive vertexes x and y = tour.next(x), which are not in the segment. If reversed,
+     * s2 is adjacent to x. The tour edges (prev, s1), (s2, next) and (x, y) are replaced by
+     * (prev, next) and either (x, s1) and (s2, y), or (x, s2) and (s1, y) if reversed.
+     * Time: 2 or 3 exchanges of the tour.
+     */
+    template <class Tour>
+    void move_segment(Tour& tour, const size_t prev, const size_t s1, const size_t s2,
+                      const size_t next, const size_t x, const size_t y,
+                      const bool reversed) noexcept {
+        if (y != prev && tour.between(next, x, prev)) {
+            // prev s1..s2 next .. x y -> prev x .. next s2..s1 y -> prev next .. x s2..s1 y
+            tour.exchange(prev, s1, x, y);
+            tour.exchange(prev, x, next, s2);
+        } else {
+            // x y .. prev s1..s2 next -> x s2..s1 prev .. y next -> x s2..s1 y .. prev next
+            tour.exchange(x, y, s2, next);
+            tour.exchange(s1, prev, y, next);
+        }
+
+        // x s2..s1 y -> x s1..s2 y
+        if (!reversed) {
+            tour.exchange(x, s2, s1, y);
+        }
+    }
+
+    /**
+     * Or-opt local search restricted to neighbor lists, with don't-look bits.
+     * An Or-opt move removes a segment of 1 to max_segment_length consecutive vertexes from the
+     * tour and inserts it, possibly reversed, in between 2 other consecutive vertexes. For every
+     * segment, only the insertion points adjacent to the nearest neighbors of its 2 endpoints
+     * are considered, and the scan of the neighbors stops as soon as w(e, c) is not shorter than
+     * what removing the segment saves, where e is an endpoint of the segment and c its neighbor.
+     * The gain of every move is computed in O(1) from the 3 edges removed and the 3 edges added.
+     * The move is applied as 2 or 3 edge exchanges of the tour.
+     * The object owns its workspace, so it can optimize many tours without allocating memory.
+     * Like in TwoOpt, the scan of the neighbors stops on Bound, a lower bound of Distance that
+     * doesn't decrease along every neighbor list, which is Distance itself by default.
+     */
+    template <class Distance, class Bound = Distance>
+    class OrOpt {
+        // maximum number of vertexes of the segments moved
+        static constexpr size_t max_segment_length = 3;
+
+        // function that returns the distance between any 2 nodes
+        Distance get_distance;
+
+        // lower bound of get_distance, sorted like the neighbor lists
+        Bound get_bound;
+
+        // neighbors[v] are the nearest neighbors of v, sorted by distance
+        const std::vector<std::vector<size_t>>& neighbors;
+
+        // vertexes still to scan
+        DontLookBits active;
+
+        // move the segment and enqueue the endpoints of the 3 edges changed, see
+        // local_search::move_segment
+        template <class Tour>
+        void move_segment(Tour& tour, const size_t prev, const size_t s1, const size_t s2,
+                          const size_t next, const size_t x, const size_t y,
+                          const bool reversed) noexcept {
+            local_search::move_segment(tour, prev, s1, s2, next, x, y, reversed);
+
+            for (const size_t v : {prev, next, s1, s2, x, y}) {
+                active.push(v);
+            }
+        }
+
+        // try to move the segments that start from s1 and go forward. If an improving move is
+        // found, apply it and return its gain, otherwise return 0.
+        template <class Tour>
+        [[nodiscard]] int improve_from(Tour& tour, const size_t s1) noexcept {
+            const size_t size = tour.size();
+            size_t s2 = s1;
+
+            for (size_t length = 1; length <= max_segment_length && length + 3 <= size;
+                 ++length, s2 = tour.next(s2)) {
+                const size_t prev = tour.prev(s1);
+                const size_t next = tour.next(s2);
+
+                // weight saved by removing the segment and joining prev and next
+                const int removal_gain =
+                    get_distance(prev, s1) + get_distance(s2, next) - get_distance(prev, next);
+
+                // return true iff v is in the segment
+                const auto in_segment = [&](const size_t v) {
+                    return tour.between(s1, v, s2);
+                };
+
+                for (const size_t e : {s1, s2}) {
+                    // the 2 endpoints of a single vertex segment are the same
+                    if (e == s2 && length == 1) {
+                        break;
+                    }
+
+                    for (const size_t c : neighbors[e]) {
+                        // the neighbors after c can't be closer than the bound of c
+                        if (get_bound(e, c) >= removal_gain) {
+                            break;
+                        }
+
+                        if (get_distance(e, c) >= removal_gain || in_segment(c)) {
+                            continue;
+                        }
+
+                        // the arcs (c, next(c)) and (prev(c), c)
+                        for (const size_t x : {c, tour.prev(c)}) {
+                            const size_t y = tour.next(x);
+                            if (in_segment(x) || in_segment(y)) {
+                                continue;
+                            }
+
+                            const int d_xy = get_distance(x, y);
+                            const int forward_gain = removal_gain + d_xy - get_distance(x, s1) -
+                                                     get_distance(s2, y);
+                            const int reversed_gain = removal_gain + d_xy - get_distance(x, s2) -
+                                                      get_distance(s1, y);
+
+                            if (forward_gain > 0 && forward_gain >= reversed_gain) {
+                                move_segment(tour, prev, s1, s2, next, x, y, false);
+                                return forward_gain;
+                            }
+
+                            if (reversed_gain > 0) {
+                                move_segment(tour, prev, s1, s2, next, x, y, true);
+                                return reversed_gain;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return 0;
+        }
+
+        // apply improving moves starting from the active vertexes until none is left
+        template <class Tour>
+        [[nodiscard]] int run(Tour& tour) noexcept {
+            int total_gain = 0;
+            while (!active.empty()) {
+                // the endpoints of the 3 edges changed by every improving move are enqueued again
+                total_gain += improve_from(tour, active.pop());
+            }
+
+            return total_gain;
+        }
+
+    public:
+        /**
+         * @param get_distance function that returns the distance between any 2 vertexes.
+         * @param neighbors nearest neighbors of every vertex, sorted by distance. See
+         *                  neighbors::k_nearest_neighbors.
+         */
+        OrOpt(Distance get_distance, const std::vector<std::vector<size_t>>& neighbors) :
+            get_distance(get_distance),
+            get_bound(std::move(get_distance)),
+            neighbors(neighbors),
+            active(neighbors.size()) {
+        }
+
+        /**
+         * @param get_distance function that returns the distance minimized between any 2
+         *                     vertexes.
+         * @param get_bound function that returns a lower bound of get_distance, which doesn't
+         *                  decrease along every neighbor list.
+         * @param neighbors nearest neighbors of every vertex, sorted by get_bound.
+         */
+        OrOpt(Distance get_distance, Bound get_bound,
+              const std::vector<std::vector<size_t>>& neighbors) :
+            get_distance(std::move(get_distance)),
+            get_bound(std::move(get_bound)),
+            neighbors(neighbors),
+            active(neighbors.size()) {
+        }
+
+        /**
+         * Apply improving Or-opt moves to tour until none is left, i.e. until tour is a local
+         * optimum with respect to the neighbor lists. Return the total decrease of the tour
+         * weight. Tour is either an ArrayTour or a TwoLevelList.
+         * Time: O(nk) per pass over the vertexes, where k is the number of neighbors, plus the
+         *       cost of the reversals.
+         */
+        template <class Tour>
+        int optimize(Tour& tour) noexcept {
+            active.reset_tour(tour);
+            return run(tour);
+        }
+
+        /**
+         * Apply improving moves to tour like optimize, but only start from the given vertexes
+         * and from the endpoints of the edges changed since then. It's meant for tours that
+         * are known to be locally optimal around every other vertex.
+         */
+        template <class Tour, class Vertexes>
+        int optimize(Tour& tour, const Vertexes& vertexes) noexcept {
+            active.reset(vertexes);
+            return run(tour);
+        }
+    };
+}  // namespace local_search
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>  // std::inplace_merge, std::max, std::min, std::sort
+#include <iterator>   // std::distance, std::next
+#include <optional>   // std::optional
+#include <thread>     // std::thread
+#include <vector>     // std::vector
+
+namespace utils {
+    /**
+     * Sort the range [first, last) according to comp using multiple threads.
+     * The range is split in one chunk per thread, every chunk is sorted independently, then
+     * adjacent chunks are merged in parallel in log2(n_threads) rounds. Small ranges are sorted
+     * on the calling thread.
+     * The sort is not stable.
+     *
+     * @param n_threads_opt optional number of threads to use. If it's not given, every CPU core
+     *                      is used.
+     */
+    template <typename RandomIt, typename Compare>
+    void parallel_sort(RandomIt first, RandomIt last, Compare comp,
+                       std::optional<size_t> n_threads_opt = {}) {
+        // below this size, the cost of spawning a thread exceeds the cost of sorting
+        constexpr size_t min_chunk_size = 1 << 14;
+
+        const auto size = static_cast<size_t>(std::distance(first, last));
+
+        // fallback on a single core if the system isn't able to detect the number of CPU cores
+        const size_t n_threads =
+            n_threads_opt.value_or(std::max(std::thread::hardware_concurrency(), 1U));
+        const size_t n_chunks = std::max<size_t>(1, std::min(n_threads, size / min_chunk_size));
+
+        if (n_chunks == 1) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        // bounds[c] is the index of the first element of the c-th chunk
+        std::vector<size_t> bounds(n_chunks + 1);
+        for (size_t c = 0; c <= n_chunks; ++c) {
+            bounds[c] = size * c / n_chunks;
+        }
+
+        const auto at = [first](const size_t index) {
+            return std::next(first, index);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(n_chunks);
+
+        // sort every chunk in its own thread
+        for (size_t c = 0; c < n_chunks; ++c) {
+            threads.emplace_back([&, c]() {
+                std::sort(at(bounds[c]), at(bounds[c + 1]), comp);
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // merge pairs of adjacent sorted runs, doubling the run width at every round
+        for (size_t width = 1; width < n_chunks; width *= 2) {
+            threads.clear();
+
+            for (size_t c = 0; c + width < n_chunks; c += 2 * width) {
+                const size_t begin = bounds[c];
+                const size_t middle = bounds[c + width];
+                const size_t end = bounds[std::min(c + 2 * width, n_chunks)];
+
+                threads.emplace_back([&, begin, middle, end]() {
+                    std::inplace_merge(at(begin), at(middle), at(end), comp);
+                });
+            }
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+    }
+}  // namespace utils
@@ -6,6 +6,7 @@
 #endif
 
 #include <fstream>
+#include <memory>   // std::unique_ptr
 #include "EdgeWeightType.h"
 
 #include "PointReader.h"
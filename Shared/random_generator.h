@@ -1,15 +1,73 @@
 #pragma once
 
+#include <cstdint>  // uint32_t, uint64_t
+#include <limits>   // std::numeric_limits
 #include <random>
 
 namespace random_generator {
     /**
-     * Generic random generator abstract class.
+     * xoshiro256++ pseudo random number generator by Blackman and Vigna, which satisfies the
+     * UniformRandomBitGenerator requirements, so it can replace std::mt19937 in the standard
+     * distributions. Its state is 32 bytes instead of 2.5KB, and a number takes a few
+     * shifts and additions, without the periodic regeneration of the state of std::mt19937.
+     * @see https://prng.di.unimi.it
      */
-    template <typename T>
+    class Xoshiro256PlusPlus {
+        uint64_t state[4];
+
+        [[nodiscard]] static constexpr uint64_t rotl(const uint64_t x, const int k) noexcept {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        using result_type = uint64_t;
+
+        explicit Xoshiro256PlusPlus(const uint64_t seed_value) noexcept {
+            seed(seed_value);
+        }
+
+        // initialize the state with splitmix64, as suggested by the authors, so it's never 0
+        void seed(uint64_t seed_value) noexcept {
+            for (uint64_t& word : state) {
+                seed_value += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = seed_value;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        [[nodiscard]] static constexpr result_type min() noexcept {
+            return 0;
+        }
+
+        [[nodiscard]] static constexpr result_type max() noexcept {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() noexcept {
+            const uint64_t result = rotl(state[0] + state[3], 23) + state[0];
+            const uint64_t t = state[1] << 17;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+
+            return result;
+        }
+    };
+
+    /**
+     * Generic random generator abstract class, whose engine can be any UniformRandomBitGenerator
+     * that can be seeded with an unsigned int.
+     */
+    template <typename T, class Engine = std::mt19937>
     class RandomGenerator {
     protected:
-        std::mt19937 engine{std::random_device()()};
+        Engine engine{std::random_device()()};
 
     public:
         // virtual destructor because this is a base class
@@ -54,6 +112,68 @@ namespace random_generator {
         }
     };
 
+    /**
+     * Random generator for hot loops, which are dominated by the cost of the distributions of the
+     * standard library: its methods aren't virtual and never use floating point numbers, but
+     * to build a real number.
+     */
+    template <class Engine = Xoshiro256PlusPlus>
+    class FastRandomGenerator {
+        Engine engine{std::random_device()()};
+
+        // the 64 random bits of each number of engine are split in 2 batches of 32 bits, and
+        // batch holds the second one if has_batch is true
+        uint32_t batch = 0;
+        bool has_batch = false;
+
+        // return 32 random bits
+        uint32_t next_batch() noexcept {
+            if (has_batch) {
+                has_batch = false;
+                return batch;
+            }
+
+            const uint64_t bits = engine();
+            batch = static_cast<uint32_t>(bits >> 32);
+            has_batch = true;
+            return static_cast<uint32_t>(bits);
+        }
+
+    public:
+        void set_seed(unsigned int seed) {
+            engine.seed(seed);
+            has_batch = false;
+        }
+
+        // return 64 random bits
+        uint64_t bits() noexcept {
+            return engine();
+        }
+
+        // return a uniform random integer in [0, range), where 0 < range <= 2^32, with Lemire's
+        // multiply and shift method: the rejection keeps the distribution exactly uniform, and
+        // the modulo is only computed in the rare case the first product is close to a rejection.
+        // @see https://arxiv.org/abs/1805.10941
+        uint32_t bounded(const uint64_t range) noexcept {
+            uint64_t product = static_cast<uint64_t>(next_batch()) * range;
+            auto low = static_cast<uint32_t>(product);
+            if (low < range) {
+                const auto threshold = static_cast<uint32_t>((uint64_t{1} << 32) % range);
+                while (low < threshold) {
+                    product = static_cast<uint64_t>(next_batch()) * range;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+
+            return static_cast<uint32_t>(product >> 32);
+        }
+
+        // return a uniform random real number in [0, 1) with 53 random bits
+        double real() noexcept {
+            return static_cast<double>(engine() >> 11) * 0x1.0p-53;
+        }
+    };
+
     /**
      * Mock generator that implements RandomGenerator but returns a fixed value
      */
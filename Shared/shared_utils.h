@@ -2,11 +2,12 @@
 
 #include <algorithm>      // std::generate_n, std::min_element, std::max_element
 #include <cmath>          // std::floor
+#include <cerrno>         // errno, ERANGE
+#include <cstdlib>        // std::strtod, std::strtoull
 #include <iterator>       // std::inserter
 #include <iterator>       // std::next, std::advance
 #include <limits>         // std::numeric_limits
-#include <list>           // std::list
-#include <unordered_map>  // std::unordered_map
+#include <optional>       // std::optional
 #include <unordered_set>  // std::unordered_set
 #include <vector>         // std::vector
 
@@ -30,6 +31,40 @@ namespace utils {
         return pi<double> * (deg + 5.0 * min / 3.0) / 180.0;
     }
 
+    // return the number of seconds written in text, or std::nullopt if text isn't a number
+    // greater than 0 whose milliseconds fit in a long long. Command line arguments are validated
+    // with it instead of std::stod, which throws.
+    [[nodiscard]] inline std::optional<double> parse_seconds(const char* text) noexcept {
+        constexpr double max_seconds = std::numeric_limits<long long>::max() / 1000.0;
+
+        char* end = nullptr;
+        const double seconds = std::strtod(text, &end);
+        if (end == text || *end != '\0' || !(seconds > 0 && seconds < max_seconds)) {
+            return std::nullopt;
+        }
+
+        return seconds;
+    }
+
+    // return the positive integer written in text, or std::nullopt if text isn't a decimal
+    // integer greater than 0 that fits in a size_t. Command line arguments are validated with it
+    // instead of std::stoul, which throws and accepts negative numbers.
+    [[nodiscard]] inline std::optional<size_t> parse_count(const char* text) noexcept {
+        if (*text < '0' || *text > '9') {
+            return std::nullopt;
+        }
+
+        errno = 0;
+        char* end = nullptr;
+        const unsigned long long count = std::strtoull(text, &end, 10);
+        if (*end != '\0' || errno == ERANGE || count == 0 ||
+            count > std::numeric_limits<size_t>::max()) {
+            return std::nullopt;
+        }
+
+        return static_cast<size_t>(count);
+    }
+
     // generate an unordered set with integer values in range [0, n-1]
     [[nodiscard]] inline std::unordered_set<size_t> generate_range_set(size_t n) noexcept {
         std::unordered_set<size_t> set;
@@ -96,117 +131,4 @@ namespace utils {
             return x.second < y.second;
         });
     };
-
-    // return the vertex k that doesn't belong to the partial Hamiltonian circuit that
-    // maximizes or minimizes the distance δ(k, circuit) w.r.t. get_best_k.
-    // get_distance is the distance function that computes the cost between 2 nodes.
-    template <class GetBestK, typename Distance>
-    [[nodiscard]] size_t select_new_k(std::unordered_set<size_t>& not_visited,
-                                      std::vector<size_t>& circuit, Distance&& get_distance,
-                                      GetBestK&& get_best_k) noexcept {
-        // map that stores the minimum distance for each candidate vertex k
-        std::unordered_map<size_t, double> node_min_weight_map;
-        node_min_weight_map.reserve(not_visited.size());
-
-        for (const auto k : not_visited) {
-            double min_hk_weight = std::numeric_limits<double>::max();
-            for (const auto h : circuit) {
-                const double weight = get_distance(h, k);
-
-                if (weight < min_hk_weight) {
-                    min_hk_weight = weight;
-                }
-            }
-
-            // update the map with the minimum weight between h and k found up to now
-            node_min_weight_map[k] = min_hk_weight;
-        }
-
-        // both std::min_element and std::max_element need a comparator that returns true when x < y
-        auto map_comparator = [](const auto& x, const auto& y) {
-            return x.second < y.second;
-        };
-
-        // maximize or minimize distances based on comparator
-        const auto it_new_k = get_best_k(node_min_weight_map.cbegin(), node_min_weight_map.cend(),
-                                         std::move(map_comparator));
-
-        // obtain the maximum of the maximum or minimum distances δ(k, circuit)
-        const size_t new_k = it_new_k->first;
-        return new_k;
-    }
-
-    // return the vertex k that doesn't belong to the partial Hamiltonian circuit that
-    // maximizes the distance δ(k, circuit).
-    // get_distance is the distance function that computes the cost between 2 nodes.
-    template <typename Distance>
-    [[nodiscard]] size_t select_new_k_maximize(std::unordered_set<size_t>& not_visited,
-                                               std::vector<size_t>& circuit,
-                                               Distance&& get_distance) noexcept {
-        return select_new_k(not_visited, circuit, get_distance, utils::max_element);
-    }
-
-    // return the vertex k that doesn't belong to the partial Hamiltonian circuit that
-    // minimizes the distance δ(k, circuit).
-    // get_distance is the distance function that computes the cost between 2 nodes.
-    template <typename Distance>
-    [[nodiscard]] size_t select_new_k_minimize(std::unordered_set<size_t>& not_visited,
-                                               std::vector<size_t>& circuit,
-                                               Distance&& get_distance) noexcept {
-        return select_new_k(not_visited, circuit, get_distance, utils::min_element);
-    }
-
-    // find the arc (i, j) that minimizes the value of w(i, k) - w(k, j) - w(i, j)
-    // and add k in between i and j in circuit.
-    template <typename Distance>
-    void perform_best_circuit_insertion(const size_t k, std::vector<size_t>& circuit,
-                                        Distance&& get_distance) {
-        const size_t size = circuit.size();
-
-        // circuit_combinations will be sequentially modified to represent all possible insertions
-        // of the vertex k between the vertexes in circuit. We prefer this mutable approach rather
-        // than first enumerating all possible insertions and then selecting the best to keep the
-        // space complexity at O(n) instead of O(n^2).
-        // Initially, it is an ordered copy of the given circuit.
-        // We use std::list because insertions and deletions at any point are O(1).
-        std::list<size_t> circuit_insertion_list(circuit.cbegin(), circuit.cend());
-
-        // compute the first insertion possibility's weight.
-        // For example, suppose that circuit is {3,4,1} and that k = 0.
-        // The possible insertions are {0,3,4,1}, {3,0,4,1}, and {3,4,0,1}.
-        // The following block sets circuit_insertion_list to the first possible insertion
-        // ({0,3,4,1}, according to the example) and saves its circuit weight, i.e.
-        // w(0,3) + w(3,4) + w(4,1) + w(1,0).
-        auto it_list = circuit_insertion_list.begin();
-        it_list = circuit_insertion_list.insert(it_list, k);
-        const int first_weight = utils::sum_weights_as_circuit(
-            circuit_insertion_list.cbegin(), circuit_insertion_list.cend(), get_distance);
-
-        // keep track of the minimum weight
-        int min_weight = first_weight;
-
-        // keep track of the index of the list where the circuit weight is minimized
-        size_t index_min_weight = 0;
-
-        // compute the other possible insertions removing k from circuit_insertion_list and adding
-        // it again in the next suitable position. Removals and insertions are O(1) because we're
-        // using lists. Since the total possible insertions in a list with n elements is n and we
-        // already computed the first possible insertion, we need only n-2 other iterations.
-        for (size_t i = 1; i < size; ++i) {
-            it_list = circuit_insertion_list.erase(it_list);
-            it_list = circuit_insertion_list.insert(std::next(it_list), k);
-            const int weight = utils::sum_weights_as_circuit(
-                circuit_insertion_list.cbegin(), circuit_insertion_list.cend(), get_distance);
-
-            if (weight < min_weight) {
-                min_weight = weight;
-                index_min_weight = i;
-            }
-        }
-
-        // add k to the place where the circuit weight is minimized.
-        // This operation takes O(n), because circuit is a vector.
-        const auto it_insert = std::next(circuit.begin(), index_min_weight);
-        circuit.insert(it_insert, k);
-    }
 }  // namespace utils
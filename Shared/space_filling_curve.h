@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::minmax_element, std::swap
+#include <cstdint>    // std::uint32_t, std::uint64_t
+#include <optional>   // std::optional
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+#include "parallel_sort.h"
+#include "point.h"
+
+namespace space_filling_curve {
+    // the points are mapped to a 2^order x 2^order grid before computing their Hilbert index
+    constexpr unsigned order = 16;
+
+    /**
+     * Return the index of the cell (x, y) along the Hilbert curve that fills a 2^order x 2^order
+     * grid. Cells that are close along the curve are close on the plane as well.
+     * Time: O(order)
+     */
+    [[nodiscard]] inline std::uint64_t hilbert_index(std::uint32_t x, std::uint32_t y) noexcept {
+        constexpr std::uint32_t n = 1U << order;
+
+        std::uint64_t index = 0;
+        for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+            const std::uint32_t rx = (x & s) > 0 ? 1 : 0;
+            const std::uint32_t ry = (y & s) > 0 ? 1 : 0;
+            index += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+
+            // rotate the quadrant, so that the curve inside it has the standard orientation
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = n - 1 - x;
+                    y = n - 1 - y;
+                }
+
+                std::swap(x, y);
+            }
+        }
+
+        return index;
+    }
+
+    /**
+     * Space Filling Curve heuristic for the TSP on the plane: visit the points in the order in
+     * which the Hilbert curve visits them. The tour is at most O(log n) times longer than the
+     * optimal one, and on uniformly distributed points it's about 35-40% longer.
+     * Return the Hamiltonian circuit found.
+     * Time: O(n log n), dominated by sorting the points by Hilbert index.
+     *
+     * @param points the points on the plane.
+     * @param n_threads_opt optional number of threads used to sort the points. If it's not
+     *                      given, every CPU core is used.
+     */
+    [[nodiscard]] inline std::vector<size_t> hilbert_tour(
+        const std::vector<point::point_2D>& points, std::optional<size_t> n_threads_opt = {}) {
+        const size_t size = points.size();
+        if (size == 0) {
+            return {};
+        }
+
+        const auto [it_min_x, it_max_x] = std::minmax_element(
+            points.cbegin(), points.cend(), [](const auto& a, const auto& b) {
+                return a.x < b.x;
+            });
+        const auto [it_min_y, it_max_y] = std::minmax_element(
+            points.cbegin(), points.cend(), [](const auto& a, const auto& b) {
+                return a.y < b.y;
+            });
+
+        // scale both axes by the same factor, so that the curve doesn't distort distances
+        const double min_x = it_min_x->x;
+        const double min_y = it_min_y->y;
+        const double side = std::max({it_max_x->x - min_x, it_max_y->y - min_y, 1e-9});
+        const double scale = ((1U << order) - 1) / side;
+
+        // pairs (Hilbert index, point)
+        std::vector<std::pair<std::uint64_t, size_t>> keys(size);
+        for (size_t v = 0; v < size; ++v) {
+            const auto x = static_cast<std::uint32_t>((points[v].x - min_x) * scale);
+            const auto y = static_cast<std::uint32_t>((points[v].y - min_y) * scale);
+            keys[v] = {hilbert_index(x, y), v};
+        }
+
+        utils::parallel_sort(
+            keys.begin(), keys.end(),
+            [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            },
+            n_threads_opt);
+
+        std::vector<size_t> circuit(size);
+        for (size_t i = 0; i < size; ++i) {
+            circuit[i] = keys[i].second;
+        }
+
+        return circuit;
+    }
+}  // namespace space_filling_curve
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <utility>  // std::move
+#include <vector>   // std::vector
+
+#include "DontLookBits.h"
+
+namespace local_search {
+    /**
+     * 2-opt local search restricted to neighbor lists, with don't-look bits.
+     * A 2-opt move removes 2 edges of the tour and reconnects the 2 paths left the other way
+     * around. For every vertex a, only the moves that add an edge (a, c) where c is one of the
+     * nearest neighbors of a are considered, and the scan of the neighbors stops as soon as
+     * w(a, c) is not shorter than the tour edge it would replace, since no improving move can be
+     * found after that.
+     * The vertexes to scan are kept in a FIFO queue: a vertex leaves the queue when no improving
+     * move starts from it (its don't-look bit is set), and it's enqueued again when one of its
+     * tour edges changes.
+     * The object owns its workspace, so it can optimize many tours without allocating memory.
+     * Distance is any function that returns the distance between 2 vertexes, so the search also
+     * works on graphs too large to store their distance matrix.
+     * When the distance minimized isn't the one the neighbor lists are sorted by, e.g. the
+     * augmented weights of Guided Local Search, the scan stops on Bound instead: a lower bound of
+     * the distance that doesn't decrease along every neighbor list, such as the real distance.
+     */
+    template <class Distance, class Bound = Distance>
+    class TwoOpt {
+        // function that returns the distance between any 2 nodes
+        Distance get_distance;
+
+        // lower bound of get_distance, sorted like the neighbor lists
+        Bound get_bound;
+
+        // neighbors[v] are the nearest neighbors of v, sorted by distance
+        const std::vector<std::vector<size_t>>& neighbors;
+
+        // vertexes still to scan
+        DontLookBits active;
+
+        // try the moves that add the edge (a, c) for a neighbor c of a. If an improving move is
+        // found, apply it and return its gain, otherwise return 0.
+        template <class Tour>
+        [[nodiscard]] int improve_from(Tour& tour, const size_t a) noexcept {
+            const size_t a_next = tour.next(a);
+            const size_t a_prev = tour.prev(a);
+            const int d_next = get_distance(a, a_next);
+            const int d_prev = get_distance(a_prev, a);
+
+            for (const size_t c : neighbors[a]) {
+                // the neighbors after c can't be closer than the bound of c
+                const int bound_ac = get_bound(a, c);
+                if (bound_ac >= d_next && bound_ac >= d_prev) {
+                    break;
+                }
+
+                const int d_ac = get_distance(a, c);
+                if (d_ac >= d_next && d_ac >= d_prev) {
+                    continue;
+                }
+
+                // replace (a, a_next) and (c, c_next) with (a, c) and (a_next, c_next)
+                const size_t c_next = tour.next(c);
+                const int gain_next =
+                    d_next - d_ac + get_distance(c, c_next) - get_distance(a_next, c_next);
+
+                if (gain_next > 0 && c != a_next) {
+                    tour.reverse(a_next, c);
+                    active.push(a);
+                    active.push(a_next);
+                    active.push(c);
+                    active.push(c_next);
+                    return gain_next;
+                }
+
+                // replace (a_prev, a) and (c_prev, c) with (a, c) and (a_prev, c_prev)
+                const size_t c_prev = tour.prev(c);
+                const int gain_prev =
+                    d_prev - d_ac + get_distance(c_prev, c) - get_distance(a_prev, c_prev);
+
+                if (gain_prev > 0 && c != a_prev) {
+                    tour.reverse(a, c_prev);
+                    active.push(a);
+                    active.push(a_prev);
+                    active.push(c);
+                    active.push(c_prev);
+                    return gain_prev;
+                }
+            }
+
+            return 0;
+        }
+
+        // apply improving moves starting from the active vertexes until none is left
+        template <class Tour>
+        [[nodiscard]] int run(Tour& tour) noexcept {
+            int total_gain = 0;
+            while (!active.empty()) {
+                // the 4 endpoints of every improving move are enqueued again
+                total_gain += improve_from(tour, active.pop());
+            }
+
+            return total_gain;
+        }
+
+    public:
+        /**
+         * @param get_distance function that returns the distance between any 2 vertexes.
+         * @param neighbors nearest neighbors of every vertex, sorted by distance. See
+         *                  neighbors::k_nearest_neighbors.
+         */
+        TwoOpt(Distance get_distance, const std::vector<std::vector<size_t>>& neighbors) :
+            get_distance(get_distance),
+            get_bound(std::move(get_distance)),
+            neighbors(neighbors),
+            active(neighbors.size()) {
+        }
+
+        /**
+         * @param get_distance function that returns the distance minimized between any 2
+         *                     vertexes.
+         * @param get_bound function that returns a lower bound of get_distance, which doesn't
+         *                  decrease along every neighbor list.
+         * @param neighbors nearest neighbors of every vertex, sorted by get_bound.
+         */
+        TwoOpt(Distance get_distance, Bound get_bound,
+               const std::vector<std::vector<size_t>>& neighbors) :
+            get_distance(std::move(get_distance)),
+            get_bound(std::move(get_bound)),
+            neighbors(neighbors),
+            active(neighbors.size()) {
+        }
+
+        /**
+         * Apply improving 2-opt moves to tour until none is left, i.e. until tour is a local
+         * optimum with respect to the neighbor lists. Return the total decrease of the tour
+         * weight. Tour is either an ArrayTour or a TwoLevelList.
+         * Time: O(nk) per pass over the vertexes, where k is the number of neighbors, plus the
+         *       cost of the reversals.
+         */
+        template <class Tour>
+        int optimize(Tour& tour) noexcept {
+            active.reset_tour(tour);
+            return run(tour);
+        }
+
+        /**
+         * Apply improving moves to tour like optimize, but only start from the given vertexes
+         * and from the endpoints of the edges changed since then. It's meant for tours that
+         * are known to be locally optimal around every other vertex.
+         */
+        template <class Tour, class Vertexes>
+        int optimize(Tour& tour, const Vertexes& vertexes) noexcept {
+            active.reset(vertexes);
+            return run(tour);
+        }
+    };
+}  // namespace local_search
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>  // size_t
+
+#if defined(__AVX2__)
+#include <immintrin.h>  // AVX2 intrinsics
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>  // SSE2 intrinsics
+#endif
+
+#include "euclidean_distance.h"
+#include "point.h"
+
+/**
+ * Kernels that evaluate the gains of a block of 2-opt moves at once.
+ * A 2-opt sweep at a fixed position i of the tour evaluates, for many positions j, the gain of
+ * replacing the tour edges (a, b) and (c, d) with (a, c) and (b, d), where a and b are the nodes
+ * at positions i and i + 1 and c and d the nodes at positions j and j + 1:
+ * w(a, b) + w(c, d) - w(a, c) - w(b, d).
+ * The kernels read the tour by position, as an array whose last entry repeats the first node,
+ * and the weights of its edges: edge_weights[j] is w(c, d). They evaluate count consecutive
+ * positions j, where every input array starts from the first of them.
+ * Every kernel has a scalar version, which gives the same gains.
+ */
+namespace two_opt_gains {
+    /**
+     * Store in gains[k] the gain of the move that removes the tour edges (a, b) and (c, d),
+     * where c = nodes[k] and d = nodes[k + 1], for every k in [0, count).
+     * w(a, c) and w(b, d) are read from the rows of a and b of a DistanceMatrix. When it's
+     * compiled with AVX2, 8 gains are evaluated at once with gather instructions.
+     * Time: O(count)
+     *
+     * @param row_a row of a in the distance matrix, see DistanceMatrix::row.
+     * @param row_b row of b in the distance matrix.
+     * @param d_ab weight of the edge (a, b).
+     * @param nodes the count + 1 nodes of the tour that follow position j - 1.
+     * @param edge_weights the weights of the count tour edges that start from position j.
+     * @param gains the count gains evaluated.
+     */
+    inline void matrix_gains_scalar(const int* row_a, const int* row_b, const int d_ab,
+                                    const size_t* nodes, const int* edge_weights,
+                                    const size_t count, int* gains) noexcept {
+        for (size_t k = 0; k < count; ++k) {
+            gains[k] = d_ab + edge_weights[k] - row_a[nodes[k]] - row_b[nodes[k + 1]];
+        }
+    }
+
+    // vectorized matrix_gains_scalar
+    inline void matrix_gains(const int* row_a, const int* row_b, const int d_ab,
+                             const size_t* nodes, const int* edge_weights, const size_t count,
+                             int* gains) noexcept {
+        size_t k = 0;
+
+#if defined(__AVX2__)
+        static_assert(sizeof(size_t) == 8, "AVX2 gathers need 64-bit node indexes");
+
+        // load 4 node indexes, which are gathered as 64-bit indexes
+        const auto load_nodes = [nodes](const size_t first) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(nodes + first));
+        };
+
+        // gather the weights of the 8 edges from row to the nodes that start from first
+        const auto gather = [&load_nodes](const int* row, const size_t first) {
+            const __m128i low = _mm256_i64gather_epi32(row, load_nodes(first), 4);
+            const __m128i high = _mm256_i64gather_epi32(row, load_nodes(first + 4), 4);
+            return _mm256_set_m128i(high, low);
+        };
+
+        const __m256i ab = _mm256_set1_epi32(d_ab);
+        for (; k + 8 <= count; k += 8) {
+            const __m256i cd =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(edge_weights + k));
+            const __m256i ac = gather(row_a, k);
+            const __m256i bd = gather(row_b, k + 1);
+
+            const __m256i gain =
+                _mm256_sub_epi32(_mm256_add_epi32(ab, cd), _mm256_add_epi32(ac, bd));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(gains + k), gain);
+        }
+#endif
+
+        // the remaining gains, or every gain without gather instructions
+        matrix_gains_scalar(row_a, row_b, d_ab, nodes + k, edge_weights + k, count - k,
+                            gains + k);
+    }
+
+    /**
+     * Store in gains[k] the gain of the move that removes the tour edges (a, b) and (c, d),
+     * where c and d are the points (xs[k], ys[k]) and (xs[k + 1], ys[k + 1]), for every k in
+     * [0, count).
+     * w(a, c) and w(b, d) are Euclidean distances rounded to the nearest integer, computed like
+     * distance::euclidean_distance, so the kernel only applies to EUC_2D instances. 2 gains are
+     * evaluated at once with SSE2, or 4 with AVX2.
+     * Time: O(count)
+     *
+     * @param a the point at position i.
+     * @param b the point at position i + 1.
+     * @param d_ab weight of the edge (a, b).
+     * @param xs the x coordinates of the count + 1 points of the tour that follow position j - 1.
+     * @param ys the y coordinates of the same points.
+     * @param edge_weights the weights of the count tour edges that start from position j.
+     * @param gains the count gains evaluated.
+     */
+    inline void coordinate_gains_scalar(const point::point_2D& a, const point::point_2D& b,
+                                        const int d_ab, const double* xs, const double* ys,
+                                        const int* edge_weights, const size_t count,
+                                        int* gains) noexcept {
+        for (size_t k = 0; k < count; ++k) {
+            const point::point_2D c(xs[k], ys[k]);
+            const point::point_2D d(xs[k + 1], ys[k + 1]);
+            gains[k] = d_ab + edge_weights[k] - distance::euclidean_distance(a, c) -
+                       distance::euclidean_distance(b, d);
+        }
+    }
+
+    // vectorized coordinate_gains_scalar
+    inline void coordinate_gains(const point::point_2D& a, const point::point_2D& b,
+                                 const int d_ab, const double* xs, const double* ys,
+                                 const int* edge_weights, const size_t count,
+                                 int* gains) noexcept {
+        size_t k = 0;
+
+#if defined(__AVX2__)
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d one = _mm256_set1_pd(1.0);
+
+        // Euclidean distances from (x, y) to the 4 points that start from first, rounded half
+        // away from zero like std::round: the fractional part of a truncated distance is exact
+        const auto distances = [&](const double x, const double y, const size_t first) {
+            const __m256d dx = _mm256_sub_pd(_mm256_set1_pd(x), _mm256_loadu_pd(xs + first));
+            const __m256d dy = _mm256_sub_pd(_mm256_set1_pd(y), _mm256_loadu_pd(ys + first));
+            const __m256d distance =
+                _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+
+            const __m256d truncated = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(distance));
+            const __m256d round_up =
+                _mm256_cmp_pd(_mm256_sub_pd(distance, truncated), half, _CMP_GE_OQ);
+            return _mm256_cvttpd_epi32(_mm256_add_pd(truncated, _mm256_and_pd(round_up, one)));
+        };
+
+        const __m128i ab = _mm_set1_epi32(d_ab);
+        for (; k + 4 <= count; k += 4) {
+            const __m128i cd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(edge_weights + k));
+            const __m128i ac = distances(a.x, a.y, k);
+            const __m128i bd = distances(b.x, b.y, k + 1);
+
+            const __m128i gain = _mm_sub_epi32(_mm_add_epi32(ab, cd), _mm_add_epi32(ac, bd));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(gains + k), gain);
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128d half = _mm_set1_pd(0.5);
+        const __m128d one = _mm_set1_pd(1.0);
+
+        // Euclidean distances from (x, y) to the 2 points that start from first, rounded half
+        // away from zero like std::round: the fractional part of a truncated distance is exact.
+        // They are stored in the 2 lowest lanes.
+        const auto distances = [&](const double x, const double y, const size_t first) {
+            const __m128d dx = _mm_sub_pd(_mm_set1_pd(x), _mm_loadu_pd(xs + first));
+            const __m128d dy = _mm_sub_pd(_mm_set1_pd(y), _mm_loadu_pd(ys + first));
+            const __m128d distance =
+                _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+
+            const __m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(distance));
+            const __m128d round_up = _mm_cmpge_pd(_mm_sub_pd(distance, truncated), half);
+            return _mm_cvttpd_epi32(_mm_add_pd(truncated, _mm_and_pd(round_up, one)));
+        };
+
+        const __m128i ab = _mm_set1_epi32(d_ab);
+        for (; k + 2 <= count; k += 2) {
+            const __m128i cd =
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(edge_weights + k));
+            const __m128i ac = distances(a.x, a.y, k);
+            const __m128i bd = distances(b.x, b.y, k + 1);
+
+            const __m128i gain = _mm_sub_epi32(_mm_add_epi32(ab, cd), _mm_add_epi32(ac, bd));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(gains + k), gain);
+        }
+#endif
+
+        // the remaining gains, or every gain without SIMD instructions
+        coordinate_gains_scalar(a, b, d_ab, xs + k, ys + k, edge_weights + k, count - k,
+                                gains + k);
+    }
+}  // namespace two_opt_gains
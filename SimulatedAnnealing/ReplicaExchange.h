@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>   // std::atomic
+#include <cmath>    // std::exp, std::pow
+#include <numeric>  // std::iota
+#include <thread>   // std::this_thread
+#include <vector>   // std::vector
+
+#include "random_generator.h"
+
+namespace simulated_annealing {
+    /**
+     * ReplicaExchange coordinates the replicas of a Parallel Tempering search: every replica runs
+     * its own Simulated Annealing chain at a fixed temperature of a geometric ladder, and every
+     * round of steps the replicas meet at a barrier, where the ones at neighboring temperatures
+     * try to swap them with the usual replica exchange probability
+     * min{1, exp((1 / T_i - 1 / T_j) (E_i - E_j))}.
+     * Only the temperatures are swapped, so no solution is copied. The barrier is a spinning
+     * sense barrier on atomics: the last replica to arrive performs the swaps alone, then releases
+     * the others, so no lock is needed.
+     */
+    class ReplicaExchange {
+        // temperatures[r] is the temperature of rung r of the ladder, from the hottest one
+        std::vector<double> temperatures;
+
+        // rung_of[i] is the rung of replica i, replica_at[r] is the replica at rung r
+        std::vector<size_t> rung_of;
+        std::vector<size_t> replica_at;
+
+        // energies[i] is the cost of the current solution of replica i at the last barrier
+        std::vector<int> energies;
+
+        // number of replicas that joined the search so far
+        std::atomic<size_t> n_joined{0};
+
+        // number of replicas waiting at the barrier, and number of barriers passed so far
+        std::atomic<size_t> n_arrived{0};
+        std::atomic<size_t> generation{0};
+
+        // real number generator in the range [0, 1), only used by the last replica to arrive
+        random_generator::RealRandomGenerator random;
+
+        // try to swap the temperatures of the neighboring rungs (r, r + 1), where r has the
+        // parity of the current generation, so every pair is tried every 2 rounds
+        void swap_temperatures() {
+            const size_t n_rungs = temperatures.size();
+            for (size_t r = generation.load(std::memory_order_relaxed) % 2; r + 1 < n_rungs;
+                 r += 2) {
+                const size_t hot = replica_at[r];
+                const size_t cold = replica_at[r + 1];
+                const double beta_diff = 1.0 / temperatures[r + 1] - 1.0 / temperatures[r];
+                const double exponent = beta_diff * (energies[cold] - energies[hot]);
+
+                // the swap is always accepted when the hotter replica found a better solution
+                if (exponent >= 0 || random() < std::exp(exponent)) {
+                    replica_at[r] = cold;
+                    replica_at[r + 1] = hot;
+                    rung_of[cold] = r;
+                    rung_of[hot] = r + 1;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @param n_replicas number of replicas, each one run by its own thread. It must be > 0.
+         * @param hottest temperature of the first rung.
+         * @param coldest temperature of the last rung, such that 0 < coldest <= hottest.
+         */
+        ReplicaExchange(const size_t n_replicas, const double hottest, const double coldest) :
+            temperatures(n_replicas, hottest),
+            rung_of(n_replicas),
+            replica_at(n_replicas),
+            energies(n_replicas, 0),
+            random(0.0, 1.0) {
+            // geometric ladder, so the acceptance ratio of the swaps is about the same everywhere
+            const double ratio =
+                n_replicas > 1 ? std::pow(coldest / hottest, 1.0 / (n_replicas - 1)) : 1.0;
+            for (size_t r = 1; r < n_replicas; ++r) {
+                temperatures[r] = temperatures[r - 1] * ratio;
+            }
+
+            std::iota(rung_of.begin(), rung_of.end(), 0);
+            std::iota(replica_at.begin(), replica_at.end(), 0);
+        }
+
+        // return the id of a new replica, which starts at the rung with the same index
+        [[nodiscard]] size_t join() noexcept {
+            return n_joined.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // return the current temperature of replica
+        [[nodiscard]] double temperature_of(const size_t replica) const noexcept {
+            return temperatures[rung_of[replica]];
+        }
+
+        // wait until every replica reaches the barrier with the cost energy of its current
+        // solution, then return the temperature of replica for the next round.
+        // Time: O(n_replicas) for the last replica to arrive.
+        double exchange(const size_t replica, const int energy) {
+            energies[replica] = energy;
+            const size_t current = generation.load(std::memory_order_acquire);
+
+            // the release sequence of n_arrived publishes every energy to the last replica
+            if (n_arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == temperatures.size()) {
+                swap_temperatures();
+                n_arrived.store(0, std::memory_order_relaxed);
+                generation.store(current + 1, std::memory_order_release);
+            } else {
+                while (generation.load(std::memory_order_acquire) == current) {
+                    std::this_thread::yield();
+                }
+            }
+
+            return temperature_of(replica);
+        }
+    };
+}  // namespace simulated_annealing
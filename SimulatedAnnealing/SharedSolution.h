@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>   // std::atomic, std::atomic_thread_fence
+#include <climits>  // INT_MAX
+#include <vector>   // std::vector
+
+namespace simulated_annealing {
+    /**
+     * SharedSolution is the slot where the islands of a cooperative Simulated Annealing search
+     * publish the best circuit found so far, and read it back. It's a sequence lock on atomics:
+     * the version is odd while a circuit is being written, and it grows by 2 at every publication,
+     * so a reader knows when it has to retry and when there's nothing new to read. Neither
+     * publishing nor reading ever blocks: an island that can't publish or read right away simply
+     * tries again at its next migration.
+     */
+    class SharedSolution {
+        // number of publications times 2, plus 1 while a circuit is being written
+        std::atomic<size_t> version{0};
+
+        // weight of the published circuit, which is INT_MAX until the first publication
+        std::atomic<int> cost{INT_MAX};
+
+        // published circuit, whose items are atomic so that a torn read is detected and not UB
+        std::vector<std::atomic<size_t>> circuit;
+
+    public:
+        // create an empty slot for circuits of size nodes
+        explicit SharedSolution(const size_t size) : circuit(size) {
+        }
+
+        // return the current version, which is even unless a circuit is being written
+        [[nodiscard]] size_t get_version() const noexcept {
+            return version.load(std::memory_order_acquire);
+        }
+
+        // return the weight of the published circuit, or INT_MAX if nothing was published
+        [[nodiscard]] int get_cost() const noexcept {
+            return cost.load(std::memory_order_relaxed);
+        }
+
+        // publish new_circuit if it's lighter than the published one and no other island is
+        // publishing at the same time. Return true iff new_circuit was published.
+        // Time: O(n)
+        bool publish(const std::vector<size_t>& new_circuit, const int new_cost) noexcept {
+            size_t current = version.load(std::memory_order_relaxed);
+            if (new_cost >= get_cost() || current % 2 == 1 ||
+                !version.compare_exchange_strong(current, current + 1,
+                                                 std::memory_order_acquire)) {
+                return false;
+            }
+
+            // the items must not be written before the version becomes odd
+            std::atomic_thread_fence(std::memory_order_release);
+
+            // another island may have published a lighter circuit in the meantime
+            const bool is_lighter = new_cost < get_cost();
+            if (is_lighter) {
+                for (size_t i = 0; i < circuit.size(); ++i) {
+                    circuit[i].store(new_circuit[i], std::memory_order_relaxed);
+                }
+                cost.store(new_cost, std::memory_order_relaxed);
+            }
+
+            version.store(is_lighter ? current + 2 : current, std::memory_order_release);
+            return is_lighter;
+        }
+
+        // copy the published circuit to out_circuit and return its version, or return an odd
+        // number if it was being written, in which case out_circuit must be ignored.
+        // Time: O(n)
+        size_t read(std::vector<size_t>& out_circuit, int& out_cost) const {
+            const size_t before = version.load(std::memory_order_acquire);
+            if (before % 2 == 1) {
+                return before;
+            }
+
+            out_circuit.resize(circuit.size());
+            for (size_t i = 0; i < circuit.size(); ++i) {
+                out_circuit[i] = circuit[i].load(std::memory_order_relaxed);
+            }
+            out_cost = cost.load(std::memory_order_relaxed);
+
+            // the items must be read before the version is checked again
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return version.load(std::memory_order_relaxed) == before ? before : 1;
+        }
+    };
+}  // namespace simulated_annealing
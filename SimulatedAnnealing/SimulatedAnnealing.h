@@ -1,13 +1,14 @@
 #pragma once
 
-#include <algorithm>    // std::min
 #include <cmath>        // std::exp
-#include <type_traits>  // std::enable_if, std::is_base_of
+#include <type_traits>  // std::decay_t, std::enable_if, std::is_base_of, std::is_null_pointer_v
 
 #include "SimulatedAnnealingOptions.h"
 
 namespace simulated_annealing {
-    template <class Solution>
+    // Move describes how to reach a feasible neighbor of a solution, and must have an int member
+    // delta, the change of the cost due to the move
+    template <class Move>
     class SolutionBase {
     public:
         virtual ~SolutionBase() = default;
@@ -15,52 +16,65 @@ namespace simulated_annealing {
         // returns the cost of the current solution
         [[nodiscard]] virtual int fitness() const = 0;
 
-        // manipulate the current solution to create a new feasible solution
-        [[nodiscard]] virtual Solution manipulate() = 0;
+        // return a random move to a feasible neighbor of the current solution, without applying
+        // it
+        [[nodiscard]] virtual Move propose() = 0;
 
-        // remove the solution from the pool of feasible solutions
-        virtual void destroy() = 0;
+        // replace the current solution with the feasible neighbor reached by move
+        virtual void apply(const Move& move) = 0;
 
-        // mark the current solution as a good solution
-        virtual void survives(Solution& current) = 0;
+        // store a copy of the current solution as the best one
+        virtual void save_best() = 0;
     };
 
     // The Solution template class must extend SolutionBase
-    template <class Solution,
-              typename = std::enable_if<std::is_base_of<SolutionBase<Solution>, Solution>::value>>
+    template <class Solution, class Move = typename Solution::Move,
+              typename = std::enable_if<std::is_base_of<SolutionBase<Move>, Solution>::value>>
     class SimulatedAnnealing {
         double temperature;
         SimulatedAnnealingOptions options;
 
-        bool metropolis(double x, double y) {
-            return options.metropolis(temperature, x, y);
+        // cost of the best solution found so far
+        int best_cost = 0;
+
+        // true iff the current solution is the best one found so far, but it hasn't been saved
+        bool is_best_unsaved = false;
+
+        // true iff an improving move has been accepted during the current annealing step
+        bool has_improved = false;
+
+        bool metropolis(double delta) {
+            return options.metropolis(temperature, delta);
         }
 
         void anneal() {
             temperature *= options.cooling;
         }
 
-        // accept with probability 1 if the candidate solution is better than the current one.
-        // Accept with probability metropolis if the candidate solution is worse.
-        void probably_accept(Solution& new_solution, Solution& current_solution,
-                             Solution& best_solution) {
-            double candidate_fitness = new_solution.fitness();
+        // propose a random move from the current solution. Accept it with probability 1 if the
+        // candidate solution is better than the current one, and with probability metropolis if
+        // it's worse. The decision only depends on the cost delta of the move, so the solution
+        // only changes if the move is accepted.
+        // The best solution is saved only when the current solution is about to get worse than
+        // it, so a run of improving moves costs a single copy.
+        void probably_accept(Solution& solution) {
+            const Move move = solution.propose();
+
+            if (move.delta >= 0 && !metropolis(move.delta)) {
+                return;
+            }
 
-            if (candidate_fitness < current_solution.fitness()) {
-                if (current_solution != best_solution) {
-                    current_solution.destroy();
-                }
+            if (is_best_unsaved && move.delta > 0) {
+                solution.save_best();
+                is_best_unsaved = false;
+            }
 
-                current_solution = new_solution;
-                best_solution = new_solution;
-            } else if (metropolis(new_solution.fitness(), current_solution.fitness())) {
-                if (current_solution != best_solution) {
-                    current_solution.destroy();
-                }
+            solution.apply(move);
+            has_improved = has_improved || move.delta < 0;
 
-                current_solution = new_solution;
-            } else {
-                new_solution.destroy();
+            if (solution.fitness() < best_cost) {
+                best_cost = solution.fitness();
+                is_best_unsaved = true;
             }
         }
 
@@ -70,13 +84,55 @@ namespace simulated_annealing {
             options(std::forward<decltype(options)>(options)) {
         }
 
+        // start a search from the current solution, which is the best one found so far
+        void start(Solution& solution) {
+            best_cost = solution.fitness();
+            solution.save_best();
+            is_best_unsaved = false;
+        }
+
+        // run n_steps Metropolis steps on solution at the current temperature, which doesn't
+        // change. The search must have been started.
+        void run(Solution& solution, const size_t n_steps) {
+            for (size_t step = 0; step < n_steps; ++step) {
+                probably_accept(solution);
+            }
+        }
+
+        // end the search, saving the best solution found in solution, and return its cost
+        int finish(Solution& solution) {
+            if (is_best_unsaved) {
+                solution.save_best();
+                is_best_unsaved = false;
+            }
+
+            return best_cost;
+        }
+
+        void set_temperature(const double new_temperature) noexcept {
+            temperature = new_temperature;
+        }
+
+        // return the cost of the best solution found so far
+        [[nodiscard]] int get_best_cost() const noexcept {
+            return best_cost;
+        }
+
         // runs the Simulated Annealing optimization either for the specified amount of annealing
-        // steps, or until the temperature reaches its minimum, whatever happens first.
-        int solve(Solution initial_solution) {
-            auto current_solution = initial_solution;
-            auto best_solution = initial_solution;
+        // steps, or until the temperature reaches its minimum, whatever happens first. Return the
+        // cost of the best solution found, which is saved in solution.
+        int solve(Solution& solution) {
+            return solve(solution, nullptr);
+        }
+
+        // same as solve(solution), but migrate(solution) is called every migration_interval
+        // annealing steps, after the best solution has been saved, unless migrate is nullptr.
+        // migrate may replace the current solution, e.g. with a better one found by another
+        // search.
+        template <class Migrate>
+        int solve(Solution& solution, Migrate&& migrate) {
+            start(solution);
 
-            int best_cost = best_solution.fitness();
             size_t same_best_solution_times = 1;
 
             for (size_t r = 0; r < options.restarts; ++r) {
@@ -90,35 +146,40 @@ namespace simulated_annealing {
                             options.get_init_temperature() * options.reheat_factor / (10 * (i + 1));
                     }
 
+                    has_improved = false;
                     for (size_t j = 0; j < options.steady_steps; ++j) {
-                        // generate a new solution manipulating the current solution
-                        auto new_solution = current_solution.manipulate();
-
-                        // accept the new solution with a probability dependent on the metropolis
-                        // policy
-                        probably_accept(new_solution, current_solution, best_solution);
+                        // move to a neighbor of the current solution with a probability
+                        // dependent on the metropolis policy
+                        probably_accept(solution);
                     }
 
                     anneal();
 
-                    // prune the feasible solutions while keeping the best solution and the current
-                    // solution
-                    best_solution.survives(current_solution);
+                    if constexpr (!std::is_null_pointer_v<std::decay_t<Migrate>>) {
+                        if (options.migration_interval > 0 &&
+                            (i + 1) % options.migration_interval == 0) {
+                            finish(solution);
+                            migrate(solution);
+                            if (solution.fitness() < best_cost) {
+                                best_cost = solution.fitness();
+                                is_best_unsaved = true;
+                            }
+                        }
+                    }
 
-                    // keeps track of the best solution cost found up to now, regardless of what
-                    // best_solution is
-                    if (best_solution.fitness() == best_cost) {
-                        ++same_best_solution_times;
-                    } else {
-                        best_cost = std::min({best_cost, best_solution.fitness()});
+                    // keeps track of how many annealing steps in a row didn't improve the current
+                    // solution
+                    if (has_improved) {
                         same_best_solution_times = 1;
+                    } else {
+                        ++same_best_solution_times;
                     }
                 }
 
                 temperature = options.get_init_temperature();
             }
 
-            return best_solution.fitness();
+            return finish(solution);
         }
     };
 
@@ -1,10 +1,32 @@
 #pragma once
 
+#include <array>    // std::array
+#include <cmath>    // std::exp, std::log
+#include <cstdint>  // uint64_t
+
 #include "random_generator.h"
 
 namespace simulated_annealing {
+    // number of leading bits of a uniform random number u in [0, 1) that select its bucket in the
+    // Metropolis acceptance table
+    constexpr int metropolis_table_bits = 10;
+
+    // return the table t where t[i] = -log(i / 2^metropolis_table_bits), so -log(u) is in
+    // (t[i + 1], t[i]] for every u in the bucket i
+    inline std::array<double, (1 << metropolis_table_bits) + 1> make_metropolis_table() {
+        std::array<double, (1 << metropolis_table_bits) + 1> table{};
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = -std::log(static_cast<double>(i) / (1 << metropolis_table_bits));
+        }
+
+        return table;
+    }
+
     class SimulatedAnnealingOptions {
-        random_generator::RealRandomGenerator rand;
+        random_generator::FastRandomGenerator<> rand;
+
+        // bounds of -log(u) in every bucket of u, shared by every thread
+        static inline const auto metropolis_table = make_metropolis_table();
 
         // initial temperature τ_0
         double init_temperature = 0;
@@ -13,8 +35,26 @@ namespace simulated_annealing {
         size_t reheat_interval = 0;
 
     public:
-        bool metropolis(double temperature, double x, double y) {
-            return rand() <= std::exp(-(x - y) / temperature);
+        // return true with probability exp(-delta / temperature), where delta is the cost increase
+        // of an uphill transition, i.e. iff -log(u) >= delta / temperature for a uniform random u
+        // in [0, 1). The bucket of u in metropolis_table decides without computing any logarithm,
+        // unless delta / temperature is in the same bucket as -log(u), which happens with
+        // probability 2^-metropolis_table_bits.
+        bool metropolis(double temperature, double delta) {
+            const double threshold = delta / temperature;
+            const uint64_t bits = rand.bits();
+            const uint64_t bucket = bits >> (64 - metropolis_table_bits);
+
+            if (threshold <= metropolis_table[bucket + 1]) {
+                return true;
+            }
+            if (threshold > metropolis_table[bucket]) {
+                return false;
+            }
+
+            // u has 53 random bits, whose leading ones are the bucket
+            const double u = static_cast<double>(bits >> 11) * 0x1.0p-53;
+            return u == 0 || -std::log(u) >= threshold;
         }
 
         // number of annealing iterations
@@ -28,7 +68,8 @@ namespace simulated_annealing {
         // temperature that, when reached, stops the optimization process
         const double stop_temperature;
 
-        // stop when the best solution stays the same for the specified amount of times
+        // stop when no annealing step accepts an improving move for the specified amount of
+        // times, i.e. when the search is frozen
         const size_t max_same_best_solution_times;
 
         // percentage of proposed uphill transitions that must be accepted at τ_0
@@ -41,6 +82,21 @@ namespace simulated_annealing {
         // factor by which the temperature will be multiplied during reheating
         const double reheat_factor;
 
+        // number of steps of every Parallel Tempering replica between two replica exchanges
+        const size_t swap_interval;
+
+        // ratio between the coldest and the hottest temperature of the Parallel Tempering ladder,
+        // whose hottest temperature is τ_0
+        const double coldest_ratio;
+
+        // number of annealing steps between two migrations of the island model, where every
+        // island publishes its best solution and adopts the global best one. 0 disables them.
+        const size_t migration_interval;
+
+        // probability that an island recombines its solution with the global best one instead of
+        // adopting it
+        const double recombination_rate;
+
         void set_init_temperature(double init_temperature) noexcept {
             this->init_temperature = init_temperature;
         }
@@ -66,8 +122,11 @@ namespace simulated_annealing {
                                            size_t max_same_best_solution_times = 150,
                                            double init_acceptance_ratio = 0.94,
                                            double cooling = 0.994,
-                                           double reheat_factor = 0.8) noexcept :
-            rand(random_generator::RealRandomGenerator(0.0, 1.0)),
+                                           double reheat_factor = 0.8,
+                                           size_t swap_interval = 1000,
+                                           double coldest_ratio = 1e-6,
+                                           size_t migration_interval = 500,
+                                           double recombination_rate = 0) noexcept :
             annealing_steps(annealing_steps),
             steady_steps(steady_steps),
             restarts(restarts),
@@ -75,7 +134,11 @@ namespace simulated_annealing {
             max_same_best_solution_times(max_same_best_solution_times),
             init_acceptance_ratio(init_acceptance_ratio),
             cooling(cooling),
-            reheat_factor(reheat_factor) {
+            reheat_factor(reheat_factor),
+            swap_interval(swap_interval),
+            coldest_ratio(coldest_ratio),
+            migration_interval(migration_interval),
+            recombination_rate(recombination_rate) {
         }
     };
 }  // namespace simulated_annealing
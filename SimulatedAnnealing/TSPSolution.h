@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>  // std::max
+#include <cmath>      // std::abs, std::log
+#include <cstdint>    // uint32_t
+#include <utility>    // std::move
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "SimulatedAnnealing.h"
+#include "SimulatedAnnealingOptions.h"
+#include "random_generator.h"
+#include "shared_utils.h"
+#include "utils.h"
+
+// random move from a TSP path to a neighbor path, see utils::two_opt, utils::translate and
+// utils::switching
+struct TSPMove {
+    enum class Kind { two_opt, translate, switching };
+
+    Kind kind;
+
+    // the first x items and the items at position >= y of the path aren't moved
+    size_t x;
+    size_t y;
+
+    // change of the circuit weight due to the move
+    int delta;
+};
+
+/**
+ * TSPSolution is the state of a Simulated Annealing run: the current circuit, which accepted
+ * moves change in place, and a snapshot of the best circuit found, so its memory is O(n) and
+ * no circuit is copied while searching, but for the snapshots.
+ */
+class TSPSolution : public simulated_annealing::SolutionBase<TSPMove> {
+    // graph represented as a distance matrix
+    const DistanceMatrix<int>& distance_matrix;
+
+    // current circuit and its weight
+    std::vector<size_t> path;
+    int cost;
+
+    // best circuit saved by save_best
+    std::vector<size_t> best_path;
+
+    // random generator of the moves, which draws 2 bounded integers from each 64 bit number
+    random_generator::FastRandomGenerator<> random;
+
+    // return a random index in [start, end)
+    [[nodiscard]] size_t random_index(size_t start, size_t end);
+
+    // return a random move from path, together with its cost delta
+    // Time: O(1)
+    [[nodiscard]] TSPMove random_move(const std::vector<size_t>& path);
+
+    // apply move to path in place
+    // Time: O(y - x)
+    static void apply_move(std::vector<size_t>& path, const TSPMove& move) noexcept;
+
+public:
+    using Move = TSPMove;
+
+    /**
+     * @param distance_matrix represents the graph as a Distance Matrix. It must have more than
+     *                        4 nodes.
+     * @param circuit initial Hamiltonian circuit.
+     * @param cost weight of circuit.
+     */
+    TSPSolution(const DistanceMatrix<int>& distance_matrix, std::vector<size_t> circuit,
+                const int cost) :
+        distance_matrix(distance_matrix),
+        path(std::move(circuit)),
+        cost(cost),
+        best_path(path) {
+    }
+
+    // return the weight of the current circuit
+    // Time: O(1)
+    [[nodiscard]] int fitness() const override {
+        return cost;
+    }
+
+    // return a random move to a feasible neighbor of the current circuit, and its cost delta
+    // computed from the few edges it changes.
+    // Time: O(1)
+    [[nodiscard]] TSPMove propose() override {
+        return random_move(path);
+    }
+
+    // apply move to the current circuit, reversing or rotating a segment in place
+    // Time: O(y - x)
+    void apply(const TSPMove& move) override {
+        apply_move(path, move);
+        cost += move.delta;
+    }
+
+    // copy the current circuit to the best circuit
+    // Time: O(n)
+    void save_best() override {
+        best_path = path;
+    }
+
+    // return the best circuit saved so far
+    [[nodiscard]] const std::vector<size_t>& best_circuit() const noexcept {
+        return best_path;
+    }
+
+    // replace the current circuit with circuit, whose weight is cost
+    // Time: O(n)
+    void assign(const std::vector<size_t>& circuit, const int new_cost) {
+        path = circuit;
+        cost = new_cost;
+    }
+
+    void recombine(const std::vector<size_t>& other);
+
+    void init(simulated_annealing::SimulatedAnnealingOptions& options, size_t sample_pair_size,
+              size_t sample_temperature_iterations);
+};
+
+inline size_t TSPSolution::random_index(size_t start, size_t end) {
+    return start + random.bounded(end - start);
+}
+
+inline TSPMove TSPSolution::random_move(const std::vector<size_t>& path) {
+    const auto get_distance = [this](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const size_t size = path.size();
+
+    // ensure that the first node isn't involved in the manipulation, which is harmless since the
+    // path is a circuit. The last node can be moved, otherwise the edge that closes the circuit
+    // would never change.
+    // we assume length of the path > 4 and k >= 2
+    const size_t k = 2;
+
+    // x and j are the selected endpoints used for manipulating the previous solution to create a
+    // new solution.
+    // The first x items and the items at position >= y will be always copied as they are.
+    const size_t x = random_index(1, size - k);
+    const size_t y = x + random_index(2, size - x + 1);
+
+    // the dice has 5 equiprobable faces
+    const uint32_t dice = random.bounded(5);
+
+    /**
+     * - 40% of probability of performing a 2-opt step;
+     * - 40% of probability of performing a translate step;
+     * - 20% of probability of performing a switching step
+     */
+
+    if (dice < 2) {
+        return {TSPMove::Kind::two_opt, x, y, utils::two_opt_delta(path, x, y, get_distance)};
+    }
+    if (dice < 4) {
+        return {TSPMove::Kind::translate, x, y, utils::translate_delta(path, x, y, get_distance)};
+    }
+    return {TSPMove::Kind::switching, x, y, utils::switching_delta(path, x, y, get_distance)};
+}
+
+inline void TSPSolution::apply_move(std::vector<size_t>& path, const TSPMove& move) noexcept {
+    switch (move.kind) {
+        case TSPMove::Kind::two_opt:
+            utils::two_opt(path, move.x, move.y);
+            break;
+        case TSPMove::Kind::translate:
+            utils::translate(path, move.x, move.y);
+            break;
+        case TSPMove::Kind::switching:
+            utils::switching(path, move.x, move.y);
+            break;
+    }
+}
+
+/**
+ * Replace the current circuit with its order crossover with other: a random segment of the
+ * current circuit is kept as it is, and it's followed by the remaining nodes in the order they
+ * have in other, so the child inherits the relative order of the nodes of both circuits.
+ * Time: O(n)
+ */
+inline void TSPSolution::recombine(const std::vector<size_t>& other) {
+    const size_t size = path.size();
+    const size_t first = random_index(0, size);
+    const size_t last = first + 1 + random_index(0, size - first);
+
+    std::vector<bool> is_kept(size, false);
+    std::vector<size_t> child(path.cbegin() + first, path.cbegin() + last);
+    child.reserve(size);
+    for (const size_t node : child) {
+        is_kept[node] = true;
+    }
+
+    for (const size_t node : other) {
+        if (!is_kept[node]) {
+            child.push_back(node);
+        }
+    }
+
+    const auto get_distance = [this](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    path = std::move(child);
+    cost = utils::sum_weights_as_circuit(path.cbegin(), path.cend(), get_distance);
+}
+
+// @param sample_size size n of R, a sample of 2n randomly generated solutions
+
+/**
+ * Initialize some core Simulated Annealing options for the current circuit, which was built
+ * by the Greedy Edge heuristic.
+ * The initial annealing temperature τ_0 is determined using the approach suggested by Ben-Ameur,
+ * @see
+ * https://www.researchgate.net/publication/227061666_Computing_the_Initial_Temperature_of_Simulated_Annealing.
+ *
+ * The reheating interval ρ is determined by max{τ_0 / 4000, 100}.
+ */
+inline void TSPSolution::init(simulated_annealing::SimulatedAnnealingOptions& options,
+                              size_t sample_pair_size, size_t sample_temperature_iterations) {
+    // percentage of proposed uphill transitions that must be accepted at τ_0
+    // (0.8 <= χ_0 <= 0.99)
+    const double init_acceptance_ratio = options.init_acceptance_ratio;
+
+    // average absolute difference in objective function over the n sample transitions composing a
+    // sample of 2n solutions
+    double delta_v = 0;
+
+    // the difference between a random neighbor n1 of the initial solution and a random neighbor
+    // n2 of n1 is the delta of the move from n1 to n2
+    std::vector<size_t> n1(path.size());
+
+    const auto trials = 2 * sample_pair_size;
+    for (size_t r = 0; r < trials; ++r) {
+        n1 = path;
+        apply_move(n1, random_move(n1));
+        delta_v += std::abs(random_move(n1).delta);
+    }
+
+    // initial temperature τ_0
+    double init_temperature = delta_v / std::log(1.0 / init_acceptance_ratio);
+
+    std::vector<size_t> current_path(path.size());
+
+    for (size_t accepted = 0;; accepted = 0, init_temperature *= 1.5) {
+        current_path = path;
+
+        for (size_t i = 0; i < sample_temperature_iterations; ++i) {
+            const TSPMove move = random_move(current_path);
+
+            if (move.delta < 0 || options.metropolis(init_temperature, move.delta)) {
+                apply_move(current_path, move);
+                ++accepted;
+            }
+        }
+
+        const auto acc = static_cast<double>(accepted);
+        const auto sample_it = static_cast<double>(sample_temperature_iterations);
+
+        if ((acc / sample_it) >= init_acceptance_ratio) {
+            break;
+        }
+    }
+
+    // set the values of τ_0 and ρ for the current instance
+    options.set_init_temperature(init_temperature);
+    options.set_reheat_interval(std::max(static_cast<int>(init_temperature / 4000), 100));
+}
@@ -1,3 +1,4 @@
+#include <cstring>   // std::strcmp
 #include <iostream>  // std::cout, std::endl
 
 #include "DistanceMatrix.h"
@@ -7,8 +8,20 @@
 #include <iostream>
 
 int main(int argc, char** argv) {
-    if (argc != 2) {
-        std::cerr << "1 argument required: filename" << std::endl;
+    // the CPU cores run independent chains, unless Parallel Tempering or islands are requested
+    auto mode = simulated_annealing::Mode::independent;
+    bool is_mode_valid = argc == 2;
+    if (argc == 3 && std::strcmp(argv[2], "--tempering") == 0) {
+        mode = simulated_annealing::Mode::tempering;
+        is_mode_valid = true;
+    } else if (argc == 3 && std::strcmp(argv[2], "--islands") == 0) {
+        mode = simulated_annealing::Mode::islands;
+        is_mode_valid = true;
+    }
+
+    if (!is_mode_valid) {
+        std::cerr << "1 argument required: filename. Optional argument: --tempering or --islands"
+                  << std::endl;
         exit(0);
     }
 
@@ -18,7 +31,7 @@ int main(int argc, char** argv) {
 
     // calculate the weight of TSP with Farthest Insertion Heuristic
     const auto total_weight =
-        simulated_annealing_tsp(std::forward<decltype(distance_matrix)>(distance_matrix));
+        simulated_annealing_tsp(std::forward<decltype(distance_matrix)>(distance_matrix), mode);
 
     // use std::fixed to avoid displaying numbers in scientific notation
     std::cout << std::fixed << total_weight << std::endl;
@@ -1,87 +1,182 @@
 #pragma once
 
 #include <algorithm>  // std::max
+#include <optional>   // std::optional
+#include <thread>     // std::thread
 #include <vector>     // std::vector
 
 #include "DistanceMatrix.h"
+#include "ReplicaExchange.h"
+#include "SharedSolution.h"
 #include "SimulatedAnnealing.h"
 #include "SimulatedAnnealingOptions.h"
-#include "TSPSolutionPool.h"
-#include "nearest_neighbor_heuristic_tsp.h"
+#include "TSPSolution.h"
+#include "greedy_edge.h"
 #include "parallel_executor.h"
 #include "random_generator.h"
-#include "sequential_executor.h"
 #include "shared_utils.h"
 
-[[nodiscard]] int simulated_annealing_tsp(DistanceMatrix<int>&& distance_matrix) {
+namespace simulated_annealing {
+    // how the CPU cores cooperate: every core runs an independent Simulated Annealing chain, the
+    // chains are the replicas of a Parallel Tempering search, or they are islands that share
+    // their best solution
+    enum class Mode { independent, tempering, islands };
+}  // namespace simulated_annealing
+
+// minimum number of Parallel Tempering replicas, so the temperature ladder isn't too coarse even
+// with few CPU cores
+constexpr size_t min_replicas = 8;
+
+// Ben-Ameur initialization parameters. These values are arbitrary, but they resulted in good
+// experimental results.
+inline size_t sample_pair_size(const size_t size) noexcept {
+    return (size / 20) + 1;
+}
+constexpr size_t sample_temperature_iterations = 5;
+
+/**
+ * Parallel Tempering for the Metric-TSP, starting every replica from circuit. The replicas run
+ * the Simulated Annealing moves at fixed temperatures of a geometric ladder from τ_0 down to
+ * τ_0 * coldest_ratio, and swap them every swap_interval steps, see
+ * simulated_annealing::ReplicaExchange. Every replica runs as many steps as an independent
+ * chain could. Return the weight of the best circuit found.
+ */
+[[nodiscard]] inline int parallel_tempering_tsp(const DistanceMatrix<int>& distance_matrix,
+                                                const std::vector<size_t>& circuit,
+                                                const int cost) {
+    simulated_annealing::SimulatedAnnealingOptions options{};
+
+    // τ_0 is computed once, and it's the temperature of the hottest replica
+    TSPSolution sample(distance_matrix, circuit, cost);
+    sample.init(options, sample_pair_size(circuit.size()), sample_temperature_iterations);
+
+    const size_t n_replicas =
+        std::max(static_cast<size_t>(std::thread::hardware_concurrency()), min_replicas);
+    const size_t n_rounds =
+        options.annealing_steps * options.steady_steps * options.restarts / options.swap_interval;
+
+    simulated_annealing::ReplicaExchange ladder(n_replicas, options.get_init_temperature(),
+                                                options.get_init_temperature() *
+                                                    options.coldest_ratio);
+
+    auto replica = [&]() {
+        const size_t id = ladder.join();
+        TSPSolution solution(distance_matrix, circuit, cost);
+
+        // the options aren't copied, so every replica has its own random generator
+        simulated_annealing::SimulatedAnnealing<TSPSolution> sa_optimizer(
+            simulated_annealing::SimulatedAnnealingOptions{});
+
+        sa_optimizer.start(solution);
+        sa_optimizer.set_temperature(ladder.temperature_of(id));
+        for (size_t round = 0; round < n_rounds; ++round) {
+            sa_optimizer.run(solution, options.swap_interval);
+            sa_optimizer.set_temperature(ladder.exchange(id, solution.fitness()));
+        }
+
+        return sa_optimizer.finish(solution);
+    };
+
+    // every replica needs its own thread, since they wait for each other at every exchange
+    const auto executor(executor::parallel_executor(n_replicas, std::move(replica)));
+
+    return executor.get_best_result(utils::min_element);
+}
+
+/**
+ * Simulated Annealing for the Metric-TSP, starting from the Greedy Edge circuit.
+ * Return the weight of the best circuit found.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param mode whether the CPU cores run independent chains, a Parallel Tempering search or
+ *             cooperating islands.
+ * @param n_workers_opt optional number of chains or islands. If it's not given, every CPU core is
+ *                      used. It's ignored by Parallel Tempering.
+ */
+[[nodiscard]] int simulated_annealing_tsp(
+    DistanceMatrix<int>&& distance_matrix,
+    const simulated_annealing::Mode mode = simulated_annealing::Mode::independent,
+    std::optional<size_t>&& n_workers_opt = {}) {
     const size_t size = distance_matrix.size();
-    random_generator::IntegerRandomGenerator rand_int(0, size - 1);
 
     const auto get_distance = [&](const size_t x, const size_t y) {
         return distance_matrix.at(x, y);
     };
 
-    // generate the first feasible solution using the Nearest Neighbor heuristic.
-    // The heuristic is sequentially executed 10 times, but only the best solution and its cost are
-    // returned.
-    auto initial_solution_factory = [&]() -> std::pair<std::vector<size_t>, int> {
-        const size_t trials = 10;
-
-        const auto executor(executor::sequential_executor({trials}, [&]() {
-            const auto result = nearest_neighbor_heuristic_tsp(distance_matrix, rand_int);
-            const auto result_cost =
-                utils::sum_weights_as_circuit(result.cbegin(), result.cend(), get_distance);
+    // generate the first feasible solution using the Greedy Edge heuristic. It's deterministic, so
+    // it's computed only once and then shared by every Simulated Annealing thread.
+    const std::vector<size_t> greedy_circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    const int greedy_cost =
+        utils::sum_weights_as_circuit(greedy_circuit.cbegin(), greedy_circuit.cend(), get_distance);
 
-            return std::make_pair(result, result_cost);
-        }));
+    if (mode == simulated_annealing::Mode::tempering) {
+        return parallel_tempering_tsp(distance_matrix, greedy_circuit, greedy_cost);
+    }
 
-        return executor.get_best_result(utils::select_best_result_cost_pair);
-    };
+    // best circuit published by the islands
+    simulated_annealing::SharedSolution shared(size);
 
-    // solves the TSP problem using Simulated Annealing starting from the solution returned by
-    // initial_solution_factory
+    // solves the TSP problem using Simulated Annealing starting from the Greedy Edge circuit
     auto solve_tsp = [&]() {
-        // maximum number of feasible solutions considered after every Simulated Annealing
-        // iterations. If the generated feasible solutions are more than this number, they are
-        // pruned away. The higher this parameter, the more RAM memory is required, but also the
-        // bigger is the hypothesis space explored. In practice, it's better to have a relatively
-        // high number for small inputs and a small number for large inputs.
-        constexpr size_t pool_solutions_prune_size = 128;
-
-        // if true, the oldest feasible solutions are discarded during pruning
-        constexpr bool prefer_new_solutions = true;
-
-        // instantiate the TSP solution pool, which is responsible of keeping track of the feasible
-        // solutions and initializing the best initial temperature according to the input.
-        TSPSolutionPool pool(
-            distance_matrix,
-            std::forward<decltype(initial_solution_factory)>(initial_solution_factory),
-            pool_solutions_prune_size, prefer_new_solutions);
+        // the current circuit, changed in place by the accepted moves, and the best circuit found
+        TSPSolution solution(distance_matrix, greedy_circuit, greedy_cost);
 
         // we use the default Simulated Annealing options. The initial temperature
         simulated_annealing::SimulatedAnnealingOptions options{};
 
-        // Ben-Ameur initialization parameters. These values are arbitrary, but they resulted in
-        // good experimental results.
-        const size_t sample_pair_size = (size / 20) + 1;
-        const size_t sample_temperature_iterations = 5;
+        // the initial temperature and the reheating interval are determined using Ben-Ameur
+        // initialization
+        solution.init(options, sample_pair_size(size), sample_temperature_iterations);
 
-        // the initial feasible solution is returned. The initial temperature and the reheating
-        // interval is determined using Ben-Ameur initialization.
-        const auto initial_solution =
-            pool.init(options, sample_pair_size, sample_temperature_iterations);
+        const double recombination_rate = options.recombination_rate;
 
         // initialize the Simulated Annealing solver object
         simulated_annealing::SimulatedAnnealing<TSPSolution> sa_optimizer(
             std::forward<decltype(options)>(options));
 
         // run the Simulated Annealing process starting from the initial solution, and return the
-        // best solution found
-        return sa_optimizer.solve(initial_solution);
+        // cost of the best solution found
+        if (mode == simulated_annealing::Mode::independent) {
+            return sa_optimizer.solve(solution);
+        }
+
+        // last version of the shared circuit read by this island, and a buffer to read it
+        size_t seen_version = 0;
+        std::vector<size_t> global_circuit;
+        int global_cost = 0;
+        random_generator::RealRandomGenerator random(0.0, 1.0);
+
+        // publish the best circuit of this island, then replace the current circuit with the
+        // global best one, or with their recombination, if it's lighter than the best circuit
+        // of this island and it wasn't read yet. An island whose best circuit is the global best
+        // one keeps its current circuit, however heavy, so the islands stay diverse.
+        const auto migrate = [&](TSPSolution& solution) {
+            shared.publish(solution.best_circuit(), sa_optimizer.get_best_cost());
+            if (shared.get_cost() >= sa_optimizer.get_best_cost() ||
+                shared.get_version() == seen_version) {
+                return;
+            }
+
+            const size_t version = shared.read(global_circuit, global_cost);
+            if (version % 2 == 1) {
+                return;
+            }
+
+            seen_version = version;
+            if (random() < recombination_rate) {
+                solution.recombine(global_circuit);
+            } else {
+                solution.assign(global_circuit, global_cost);
+            }
+        };
+
+        return sa_optimizer.solve(solution, migrate);
     };
 
-    // run Simulated Annealing as many times as the number of CPU cores
-    const auto executor(executor::parallel_executor({}, std::move(solve_tsp)));
+    // run Simulated Annealing as many times as the number of workers, by default the number of CPU
+    // cores
+    const auto executor(
+        executor::parallel_executor(std::move(n_workers_opt), std::move(solve_tsp)));
 
     // return the best cost found
     return executor.get_best_result(utils::min_element);
@@ -1,80 +1,78 @@
 #pragma once
 
-#include <vector>  // std::vector
+#include <algorithm>  // std::reverse, std::rotate
+#include <utility>    // std::swap
+#include <vector>     // std::vector
 
 namespace utils {
+    // reverse the items at positions in [x, y)
+    // Time: O(y - x)
     template <typename T>
-    void two_opt(const std::vector<T>& path, std::vector<T>& new_path, size_t x,
-                 size_t y) noexcept {
-        size_t i = 0;
-        size_t j = 0;
-
-        // copy the first x items
-        for (; i < x; i++, j++) {
-            new_path[j] = path[i];
-        }
-
-        // copy the reversed version of the next x items
-        for (i = y - 1; i >= x; i--, j++) {
-            new_path[j] = path[i];
-        }
-
-        // copy the last part
-        for (i = y; i < path.size(); i++, j++) {
-            new_path[j] = path[i];
-        }
+    void two_opt(std::vector<T>& path, size_t x, size_t y) noexcept {
+        std::reverse(path.begin() + x, path.begin() + y);
     }
 
+    // move the item at position y-1 to position x, shifting the items at positions in [x, y-1)
+    // forward by 1
+    // Time: O(y - x)
     template <typename T>
-    void translate(const std::vector<T>& path, std::vector<T>& new_path, size_t x,
-                   size_t y) noexcept {
-        size_t i = 0;
-        size_t j = 0;
-
-        // copy the first x items
-        for (; i < x; i++, j++) {
-            new_path[j] = path[i];
-        }
-
-        // copy the item at position y-1
-        new_path[j++] = path[y - 1];
-
-        // copy the next y-x-1 items
-        for (i = x; i < y - 1; i++, j++) {
-            new_path[j] = path[i];
-        }
-
-        // copy the last part
-        for (i = y; i < path.size(); i++, j++) {
-            new_path[j] = path[i];
-        }
+    void translate(std::vector<T>& path, size_t x, size_t y) noexcept {
+        std::rotate(path.begin() + x, path.begin() + (y - 1), path.begin() + y);
     }
 
+    // swap the items at positions x and y-1
+    // Time: O(1)
     template <typename T>
-    void switching(const std::vector<T>& path, std::vector<T>& new_path, size_t x,
-                   size_t y) noexcept {
-        size_t i = 0;
-        size_t j = 0;
+    void switching(std::vector<T>& path, size_t x, size_t y) noexcept {
+        std::swap(path[x], path[y - 1]);
+    }
 
-        // copy the first x items
-        for (; i < x; i++, j++) {
-            new_path[j] = path[i];
-        }
+    // return the change of the circuit weight due to two_opt(path, x, y), which replaces the
+    // edges (path[x-1], path[x]) and (path[y-1], path[y]).
+    // We assume 1 <= x and x + 2 <= y <= path.size(), where path[path.size()] is path[0].
+    // Time: O(1)
+    template <typename T, class Distance>
+    [[nodiscard]] int two_opt_delta(const std::vector<T>& path, size_t x, size_t y,
+                                    const Distance& get_distance) noexcept {
+        const T& after = path[y < path.size() ? y : 0];
+        return get_distance(path[x - 1], path[y - 1]) + get_distance(path[x], after) -
+               get_distance(path[x - 1], path[x]) - get_distance(path[y - 1], after);
+    }
 
-        // copy the item at position y-1
-        new_path[j++] = path[y - 1];
+    // return the change of the circuit weight due to translate(path, x, y), which moves path[y-1]
+    // in between path[x-1] and path[x].
+    // We assume 1 <= x and x + 2 <= y <= path.size(), where path[path.size()] is path[0].
+    // Time: O(1)
+    template <typename T, class Distance>
+    [[nodiscard]] int translate_delta(const std::vector<T>& path, size_t x, size_t y,
+                                      const Distance& get_distance) noexcept {
+        const T& moved = path[y - 1];
+        const T& after = path[y < path.size() ? y : 0];
+        return get_distance(path[x - 1], moved) + get_distance(moved, path[x]) +
+               get_distance(path[y - 2], after) - get_distance(path[x - 1], path[x]) -
+               get_distance(path[y - 2], moved) - get_distance(moved, after);
+    }
 
-        // skip the x-th item, copy the next y-x-2 items
-        for (i = x + 1; i < y - 1; i++, j++) {
-            new_path[j] = path[i];
+    // return the change of the circuit weight due to switching(path, x, y), which swaps
+    // path[x] and path[y-1].
+    // We assume 1 <= x and x + 2 <= y <= path.size(), where path[path.size()] is path[0].
+    // Time: O(1)
+    template <typename T, class Distance>
+    [[nodiscard]] int switching_delta(const std::vector<T>& path, size_t x, size_t y,
+                                      const Distance& get_distance) noexcept {
+        const T& a = path[x];
+        const T& b = path[y - 1];
+        const T& after = path[y < path.size() ? y : 0];
+
+        // the edge (a, b) is kept when a and b are adjacent
+        if (x + 2 == y) {
+            return get_distance(path[x - 1], b) + get_distance(a, after) -
+                   get_distance(path[x - 1], a) - get_distance(b, after);
         }
 
-        // copy the x-th item
-        new_path[j++] = path[x];
-
-        // copy the last part
-        for (i = y; i < path.size(); i++, j++) {
-            new_path[j] = path[i];
-        }
+        return get_distance(path[x - 1], b) + get_distance(b, path[x + 1]) +
+               get_distance(path[y - 2], a) + get_distance(a, after) -
+               get_distance(path[x - 1], a) - get_distance(a, path[x + 1]) -
+               get_distance(path[y - 2], b) - get_distance(b, after);
     }
 }  // namespace utils
@@ -0,0 +1,25 @@
+#include <iostream>  // std::cout, std::endl
+
+#include "improvement.h"
+#include "read_file.h"
+#include "space_filling_curve_tsp.h"
+
+int main(int argc, char** argv) {
+    // optional improvement stage applied to the circuit built, e.g. --2opt --oropt
+    const auto stage = improvement::parse_stage(argc, argv);
+
+    if (argc != 2) {
+        std::cerr << "1 argument required: filename. Optional flags: " << improvement::flags_usage
+                  << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+
+    // calculate the weight of TSP with the Space Filling Curve heuristic
+    const int total_weight = space_filling_curve_tsp(*point_reader, stage);
+
+    // use std::fixed to avoid displaying numbers in scientific notation
+    std::cout << std::fixed << total_weight << std::endl;
+}
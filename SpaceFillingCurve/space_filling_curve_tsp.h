@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>  // std::vector
+
+#include "PointReader.h"
+#include "improvement.h"
+#include "nearest_neighbors.h"
+#include "space_filling_curve.h"
+
+// Space Filling Curve: visit the points in the order of the Hilbert curve over their planar
+// coordinates. GEO points are projected to the plane first. Since the distance matrix isn't
+// needed, the distances of the circuit are computed on the fly by the point reader, and the
+// candidate lists of the optional improvement stage are computed on the planar coordinates.
+[[nodiscard]] inline int space_filling_curve_tsp(const point_reader::PointReader& point_reader,
+                                                 const improvement::Stage stage) {
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&point_reader](const size_t x, const size_t y) {
+        return point_reader.distance(x, y);
+    };
+
+    const std::vector<point::point_2D> points(point_reader.planar_points());
+    std::vector<size_t> circuit(space_filling_curve::hilbert_tour(points));
+
+    return improvement::improve_circuit(
+        stage, get_distance,
+        [&points]() {
+            return neighbors::k_nearest_neighbors(points, improvement::n_neighbors);
+        },
+        circuit);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>  // std::fill
+#include <cstdint>    // uint64_t
+#include <vector>     // std::vector
+
+namespace tabu {
+    /**
+     * AttributeTable stores 64 bit keys, each one until a given expiry iteration, in a fixed
+     * number of buckets of `ways` entries: a key can only be in the bucket chosen by its hash.
+     * When a bucket is full, a new key replaces the entry that expires first, so the table
+     * never allocates memory after its construction and lookups take O(ways). It's used to store
+     * the tabu edges and the signatures of the tours visited recently, where forgetting a few
+     * entries early is harmless.
+     */
+    class AttributeTable {
+        static constexpr size_t ways = 8;
+
+        // keys[b * ways + w] is the w-th key of bucket b, which is valid until the iteration
+        // expiry[b * ways + w] excluded. An entry whose expiry is 0 is empty.
+        std::vector<uint64_t> keys;
+        std::vector<size_t> expiry;
+
+        // number of buckets minus 1, which is a power of 2 minus 1
+        size_t bucket_mask;
+
+        // return the index of the first entry of the bucket of key
+        [[nodiscard]] size_t bucket_of(const uint64_t key) const noexcept {
+            return (static_cast<size_t>(key) & bucket_mask) * ways;
+        }
+
+        // return the number of buckets needed to store capacity keys at least half empty
+        [[nodiscard]] static size_t n_buckets(const size_t capacity) noexcept {
+            size_t buckets = 1;
+            while (buckets * ways < 2 * capacity) {
+                buckets *= 2;
+            }
+
+            return buckets;
+        }
+
+    public:
+        // create an empty table meant to store about capacity keys at once
+        explicit AttributeTable(const size_t capacity) :
+            keys(n_buckets(capacity) * ways, 0),
+            expiry(n_buckets(capacity) * ways, 0),
+            bucket_mask(n_buckets(capacity) - 1) {
+        }
+
+        // return true iff key is stored and it doesn't expire before iteration
+        [[nodiscard]] bool contains(const uint64_t key, const size_t iteration) const noexcept {
+            const size_t first = bucket_of(key);
+            for (size_t i = first; i < first + ways; ++i) {
+                if (keys[i] == key && expiry[i] > iteration) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // store key until the iteration until excluded, replacing the entry of the same key if
+        // any, otherwise the entry of its bucket that expires first
+        void insert(const uint64_t key, const size_t until) noexcept {
+            const size_t first = bucket_of(key);
+            size_t target = first;
+            for (size_t i = first; i < first + ways; ++i) {
+                if (keys[i] == key) {
+                    target = i;
+                    break;
+                }
+                if (expiry[i] < expiry[target]) {
+                    target = i;
+                }
+            }
+
+            keys[target] = key;
+            expiry[target] = until;
+        }
+
+        // remove every key
+        void clear() noexcept {
+            std::fill(expiry.begin(), expiry.end(), 0);
+        }
+    };
+}  // namespace tabu
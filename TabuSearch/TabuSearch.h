@@ -0,0 +1,386 @@
+#pragma once
+
+#include <algorithm>  // std::clamp, std::max, std::min
+#include <array>      // std::array
+#include <cstdint>    // uint64_t
+#include <limits>     // std::numeric_limits
+#include <vector>     // std::vector
+
+#include "ArrayTour.h"
+#include "AttributeTable.h"
+#include "DistanceMatrix.h"
+#include "double_bridge.h"
+#include "edge_hash.h"
+#include "or_opt.h"
+#include "random_generator.h"
+
+namespace tabu {
+    // maximum number of vertexes of the segments moved by Or-opt
+    constexpr size_t max_segment_length = 3;
+
+    // number of iterations the signature of a visited tour is remembered for
+    constexpr size_t history_length = 4096;
+
+    // maximum number of vertexes of the segments swapped by the restart kick
+    constexpr size_t max_kick_segment_length = 50;
+
+    /**
+     * Tabu Search for the Metric-TSP. Every step scans the whole neighborhood of the current
+     * tour, made of the 2-opt and Or-opt moves that add an edge from a vertex to one of its
+     * nearest neighbors, and applies the best admissible move even if it makes the tour worse.
+     * A move isn't admissible if it adds back an edge removed during the last few iterations
+     * (its tenure), or if it leads to a tour visited during the last history_length iterations,
+     * unless it yields a tour better than the best one found so far (aspiration).
+     * Tours are identified by their Zobrist signature, the XOR of the keys of their edges (see
+     * edge_hash::edge_key), so both the gain and the signature of a move are evaluated in O(1)
+     * from the edges it changes.
+     * After too many iterations without improvement, the search restarts from the best tour
+     * perturbed by a double bridge kick.
+     * All the memory is allocated by the constructor, steps only reuse it.
+     */
+    class TabuSearch {
+        enum class Kind { none, two_opt, or_opt };
+
+        /**
+         * A 2-opt move replaces the tour edges (a, b) and (c, d) with (a, c) and (b, d), where
+         * v = {a, b, c, d}, see ArrayTour::exchange.
+         * An Or-opt move moves the segment s1..s2 from in between prev and next to in between
+         * x and y, where v = {prev, s1, s2, next, x, y}, see local_search::move_segment.
+         */
+        struct move_t {
+            Kind kind = Kind::none;
+            int gain = 0;
+            std::array<size_t, 6> v{};
+            bool reversed = false;
+
+            // signature of the tour after the move
+            uint64_t signature = 0;
+        };
+
+        const DistanceMatrix<int>& distance_matrix;
+
+        // neighbors[v] are the nearest neighbors of v, sorted by distance
+        const std::vector<std::vector<size_t>>& neighbors;
+
+        ArrayTour tour;
+
+        // weight and signature of tour
+        int cost;
+        uint64_t signature = 0;
+
+        // best circuit found so far and its weight
+        std::vector<size_t> best_circuit;
+        int best_cost;
+
+        // number of steps made so far, and the step that found best_circuit or restarted from it
+        size_t iteration = 0;
+        size_t last_improvement = 0;
+
+        // range of the number of iterations a removed edge stays tabu
+        size_t min_tenure;
+        size_t max_tenure;
+
+        // steps without improvement before restarting from best_circuit
+        size_t max_stagnation;
+
+        // removed edges that can't be added back, and signatures of the tours visited recently
+        AttributeTable tabu_edges;
+        AttributeTable visited;
+
+        random_generator::IntegerRandomGenerator random;
+
+        // the best admissible move and the best move overall found by the current step
+        move_t best_admissible;
+        move_t best_move;
+
+        [[nodiscard]] int distance(const size_t x, const size_t y) const noexcept {
+            return distance_matrix.at(x, y);
+        }
+
+        // call removed(u, v) for every edge removed by move and added(u, v) for every edge added
+        template <class Removed, class Added>
+        static void for_each_edge(const move_t& move, Removed&& removed, Added&& added) {
+            const auto& v = move.v;
+            if (move.kind == Kind::two_opt) {
+                removed(v[0], v[1]);
+                removed(v[2], v[3]);
+                added(v[0], v[2]);
+                added(v[1], v[3]);
+            } else {
+                removed(v[0], v[1]);
+                removed(v[2], v[3]);
+                removed(v[4], v[5]);
+                added(v[0], v[3]);
+                added(v[4], move.reversed ? v[2] : v[1]);
+                added(move.reversed ? v[1] : v[2], v[5]);
+            }
+        }
+
+        // return the signature of the tour obtained by applying move to tour
+        [[nodiscard]] uint64_t signature_after(const move_t& move) const noexcept {
+            uint64_t result = signature;
+            const auto toggle = [&result](const size_t u, const size_t v) {
+                result ^= edge_hash::edge_key(u, v);
+            };
+            for_each_edge(move, toggle, toggle);
+            return result;
+        }
+
+        // return true iff move can be applied at the current iteration
+        [[nodiscard]] bool is_admissible(const move_t& move) const noexcept {
+            if (cost - move.gain < best_cost) {
+                return true;
+            }
+
+            bool is_tabu = visited.contains(move.signature, iteration);
+            for_each_edge(
+                move, [](size_t, size_t) {},
+                [&](const size_t u, const size_t v) {
+                    is_tabu = is_tabu || tabu_edges.contains(edge_hash::edge_key(u, v), iteration);
+                });
+
+            return !is_tabu;
+        }
+
+        // keep move if it's better than the best moves found so far by the current step.
+        // The tabu tables are only looked up for moves that would be kept.
+        void consider(move_t& move) noexcept {
+            const bool beats_admissible =
+                best_admissible.kind == Kind::none || move.gain > best_admissible.gain;
+            const bool beats_any = best_move.kind == Kind::none || move.gain > best_move.gain;
+            if (!beats_admissible && !beats_any) {
+                return;
+            }
+
+            move.signature = signature_after(move);
+            if (beats_any) {
+                best_move = move;
+            }
+            if (beats_admissible && is_admissible(move)) {
+                best_admissible = move;
+            }
+        }
+
+        // consider the 2-opt moves that add the edge (a, c) for a neighbor c of a
+        // Time: O(k)
+        void scan_two_opt(const size_t a) noexcept {
+            const size_t a_next = tour.next(a);
+            const size_t a_prev = tour.prev(a);
+            const int d_next = distance(a, a_next);
+            const int d_prev = distance(a_prev, a);
+
+            move_t move;
+            move.kind = Kind::two_opt;
+
+            for (const size_t c : neighbors[a]) {
+                const int d_ac = distance(a, c);
+
+                // replace (a, a_next) and (c, c_next) with (a, c) and (a_next, c_next)
+                const size_t c_next = tour.next(c);
+                if (c != a_next && c_next != a) {
+                    move.gain = d_next - d_ac + distance(c, c_next) - distance(a_next, c_next);
+                    move.v = {a, a_next, c, c_next, 0, 0};
+                    consider(move);
+                }
+
+                // replace (a_prev, a) and (c_prev, c) with (a, c) and (a_prev, c_prev)
+                const size_t c_prev = tour.prev(c);
+                if (c != a_prev && c_prev != a) {
+                    move.gain = d_prev - d_ac + distance(c_prev, c) - distance(a_prev, c_prev);
+                    move.v = {a, a_prev, c, c_prev, 0, 0};
+                    consider(move);
+                }
+            }
+        }
+
+        // consider the Or-opt moves of the segments that start from s1 and go forward, which
+        // add an edge from an endpoint of the segment to one of its neighbors
+        // Time: O(k)
+        void scan_or_opt(const size_t s1) noexcept {
+            const size_t size = tour.size();
+            size_t s2 = s1;
+
+            move_t move;
+            move.kind = Kind::or_opt;
+
+            for (size_t length = 1; length <= max_segment_length && length + 3 <= size;
+                 ++length, s2 = tour.next(s2)) {
+                const size_t prev = tour.prev(s1);
+                const size_t next = tour.next(s2);
+
+                // weight saved by removing the segment and joining prev and next
+                const int removal_gain =
+                    distance(prev, s1) + distance(s2, next) - distance(prev, next);
+
+                // return true iff v is in the segment
+                const auto in_segment = [&](const size_t v) {
+                    return tour.between(s1, v, s2);
+                };
+
+                for (const size_t e : {s1, s2}) {
+                    // the 2 endpoints of a single vertex segment are the same
+                    if (e == s2 && length == 1) {
+                        break;
+                    }
+
+                    for (const size_t c : neighbors[e]) {
+                        if (in_segment(c)) {
+                            continue;
+                        }
+
+                        // the arcs (c, next(c)) and (prev(c), c), with e adjacent to c
+                        for (const size_t x : {c, tour.prev(c)}) {
+                            const size_t y = tour.next(x);
+                            if (in_segment(x) || in_segment(y)) {
+                                continue;
+                            }
+
+                            // x s1..s2 y if s1 is adjacent to x, x s2..s1 y otherwise
+                            const bool reversed = (x == c) == (e == s2);
+                            move.gain = removal_gain + distance(x, y) -
+                                        distance(x, reversed ? s2 : s1) -
+                                        distance(reversed ? s1 : s2, y);
+                            move.v = {prev, s1, s2, next, x, y};
+                            move.reversed = reversed;
+                            consider(move);
+                        }
+                    }
+                }
+            }
+        }
+
+        void apply(const move_t& move) noexcept {
+            const auto& v = move.v;
+            if (move.kind == Kind::two_opt) {
+                tour.exchange(v[0], v[1], v[2], v[3]);
+            } else {
+                local_search::move_segment(tour, v[0], v[1], v[2], v[3], v[4], v[5],
+                                           move.reversed);
+            }
+
+            const size_t tenure = min_tenure + random() % (max_tenure - min_tenure + 1);
+            for_each_edge(
+                move,
+                [&](const size_t a, const size_t b) {
+                    tabu_edges.insert(edge_hash::edge_key(a, b), iteration + tenure);
+                },
+                [](size_t, size_t) {});
+
+            cost -= move.gain;
+            signature = move.signature;
+            visited.insert(signature, iteration + history_length);
+        }
+
+        // return the signature of tour
+        // Time: O(n)
+        [[nodiscard]] uint64_t tour_signature() const noexcept {
+            uint64_t result = 0;
+            for (const size_t v : tour.nodes()) {
+                result ^= edge_hash::edge_key(v, tour.next(v));
+            }
+
+            return result;
+        }
+
+        // replace tour with best_circuit perturbed by a random double bridge kick
+        // Time: O(n)
+        void restart() noexcept {
+            tour.assign(best_circuit);
+            cost = best_cost;
+
+            const size_t size = tour.size();
+
+            // the double bridge kick needs 8 distinct nodes
+            if (size >= 8) {
+                const size_t max_length = std::min(max_kick_segment_length, size / 2 - 1);
+                const auto kick = local_search::double_bridge_t::after(
+                    tour, random() % size, 1 + random() % max_length, 1 + random() % max_length);
+                kick.apply([this](const size_t a, const size_t b, const size_t c,
+                                  const size_t d) { tour.exchange(a, b, c, d); });
+                cost -= kick.gain([this](const size_t x, const size_t y) {
+                    return distance(x, y);
+                });
+            }
+
+            signature = tour_signature();
+            tabu_edges.clear();
+            last_improvement = iteration;
+        }
+
+    public:
+        /**
+         * @param distance_matrix represents the graph as a Distance Matrix.
+         * @param neighbors nearest neighbors of every city, sorted by distance. See
+         *                  neighbors::k_nearest_neighbors.
+         * @param circuit initial Hamiltonian circuit.
+         * @param cost weight of circuit.
+         */
+        TabuSearch(const DistanceMatrix<int>& distance_matrix,
+                   const std::vector<std::vector<size_t>>& neighbors,
+                   const std::vector<size_t>& circuit, const int cost) :
+            distance_matrix(distance_matrix),
+            neighbors(neighbors),
+            tour(distance_matrix.size()),
+            cost(cost),
+            best_circuit(circuit),
+            best_cost(cost),
+            min_tenure(std::clamp<size_t>(distance_matrix.size() / 20, 5, 20)),
+            max_tenure(2 * min_tenure),
+            max_stagnation(std::max<size_t>(distance_matrix.size() / 10, 100)),
+            tabu_edges(6 * max_tenure),
+            visited(history_length),
+            random(0, std::numeric_limits<size_t>::max()) {
+            tour.assign(circuit);
+            signature = tour_signature();
+        }
+
+        // return the weight of the current tour
+        [[nodiscard]] int get_cost() const noexcept {
+            return cost;
+        }
+
+        // return the weight of the best tour found so far
+        [[nodiscard]] int get_best_cost() const noexcept {
+            return best_cost;
+        }
+
+        // return the best circuit found so far
+        [[nodiscard]] const std::vector<size_t>& get_best_circuit() const noexcept {
+            return best_circuit;
+        }
+
+        /**
+         * Apply the best admissible move of the neighborhood to the tour, or the best move if
+         * none is admissible. Return false iff the tour has no move at all.
+         * Time: O(nk), where k is the number of neighbors, plus the cost of the move.
+         */
+        bool step() noexcept {
+            best_admissible.kind = Kind::none;
+            best_move.kind = Kind::none;
+
+            for (const size_t v : tour.nodes()) {
+                scan_two_opt(v);
+                scan_or_opt(v);
+            }
+
+            const move_t& move = best_admissible.kind != Kind::none ? best_admissible : best_move;
+            if (move.kind == Kind::none) {
+                return false;
+            }
+
+            // the move changes the order of the nodes scanned above, so it's applied after
+            apply(move);
+            ++iteration;
+
+            if (cost < best_cost) {
+                best_cost = cost;
+                tour.copy_to(best_circuit);
+                last_improvement = iteration;
+            } else if (iteration - last_improvement > max_stagnation) {
+                restart();
+            }
+
+            return true;
+        }
+    };
+}  // namespace tabu
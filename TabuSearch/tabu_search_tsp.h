@@ -0,0 +1,77 @@
+#pragma once
+
+#include <chrono>    // std::chrono
+#include <optional>  // std::optional
+#include <vector>    // std::vector
+
+#include "ArrayTour.h"
+#include "DistanceMatrix.h"
+#include "TabuSearch.h"
+#include "greedy_edge.h"
+#include "improvement.h"
+#include "nearest_neighbors.h"
+#include "or_opt.h"
+#include "parallel_executor.h"
+#include "shared_utils.h"
+#include "two_opt.h"
+
+// number of nearest neighbors of each city scanned by every tabu search step
+constexpr size_t tabu_neighbors = 5;
+
+/**
+ * Tabu Search for the Metric-TSP, starting from the Greedy Edge circuit improved by 2-opt and
+ * Or-opt on the nearest neighbors of every city. Every CPU core runs its own search until
+ * time_limit expires, see tabu::TabuSearch.
+ * Return the weight of the best circuit found.
+ * Time: O(n^2 log k) for the neighbor lists, plus O(nk) per step.
+ *
+ * @param distance_matrix represents the graph as a Distance Matrix.
+ * @param time_limit every worker stops starting new steps after this time.
+ * @param k number of nearest neighbors of each city considered by the moves.
+ * @param n_workers_opt optional number of threads to use. If it's not given, every CPU core is
+ *                      used.
+ */
+[[nodiscard]] inline int tabu_search_tsp(const DistanceMatrix<int>& distance_matrix,
+                                         const std::chrono::milliseconds time_limit,
+                                         const size_t k = tabu_neighbors,
+                                         std::optional<size_t>&& n_workers_opt = {}) {
+    constexpr auto stage = improvement::Stage::two_opt_or_opt;
+
+    const size_t size = distance_matrix.size();
+    const auto deadline = std::chrono::steady_clock::now() + time_limit;
+
+    // lambda function that returns the distance between any 2 nodes
+    const auto get_distance = [&distance_matrix](const size_t x, const size_t y) {
+        return distance_matrix.at(x, y);
+    };
+
+    const std::vector<size_t> greedy_circuit(greedy_edge::greedy_edge_circuit(distance_matrix));
+    const int greedy_cost =
+        utils::sum_weights_as_circuit(greedy_circuit.cbegin(), greedy_circuit.cend(), get_distance);
+
+    // every move needs 2 edges that don't share a node
+    if (size < 4) {
+        return greedy_cost;
+    }
+
+    const auto neighbors = neighbors::k_nearest_neighbors(distance_matrix, k);
+
+    auto worker = [&]() {
+        local_search::TwoOpt two_opt(get_distance, neighbors);
+        local_search::OrOpt or_opt(get_distance, neighbors);
+
+        ArrayTour tour(size);
+        tour.assign(greedy_circuit);
+        const int cost = greedy_cost - improvement::optimize_tour(stage, two_opt, or_opt, tour);
+
+        tabu::TabuSearch search(distance_matrix, neighbors, tour.nodes(), cost);
+        while (std::chrono::steady_clock::now() < deadline && search.step()) {
+        }
+
+        return search.get_best_cost();
+    };
+
+    const auto executor(executor::parallel_executor(std::move(n_workers_opt), std::move(worker)));
+
+    return executor.get_best_result(utils::min_element);
+}
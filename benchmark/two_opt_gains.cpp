@@ -0,0 +1,133 @@
+#include <algorithm>  // std::equal, std::shuffle
+#include <chrono>     // std::chrono
+#include <iostream>   // std::cout, std::endl
+#include <numeric>    // std::iota
+#include <random>     // std::mt19937
+#include <vector>     // std::vector
+
+#include "DistanceMatrix.h"
+#include "euclidean_distance.h"
+#include "point.h"
+#include "read_file.h"
+#include "two_opt_gains.h"
+
+// the distance matrix is only built for graphs up to this size
+constexpr size_t max_matrix_size = 10000;
+
+// every kernel runs sweeps for at least this time
+constexpr std::chrono::milliseconds min_duration(500);
+
+/**
+ * Microbenchmark of the kernels of two_opt_gains: for a random tour of the given graph, every
+ * sweep fixes a position i and evaluates the gains of the 2-opt moves of every position j, and
+ * the number of moves evaluated per second is reported for the scalar and the vectorized
+ * version of each kernel. The vectorized gains are checked against the scalar ones.
+ */
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "1 argument required: filename" << std::endl;
+        exit(0);
+    }
+
+    const char* filename = argv[1];
+    auto point_reader(read_file(filename));
+    const size_t size = point_reader->size();
+    const std::vector<point::point_2D> points(point_reader->planar_points());
+
+    // random tour, stored by position with the first node repeated at the end
+    std::vector<size_t> nodes(size + 1);
+    std::iota(nodes.begin(), nodes.end() - 1, 0);
+    std::shuffle(nodes.begin(), nodes.end() - 1, std::mt19937(0));
+    nodes[size] = nodes[0];
+
+    std::vector<double> xs(size + 1);
+    std::vector<double> ys(size + 1);
+    std::vector<int> edge_weights(size);
+    for (size_t j = 0; j <= size; ++j) {
+        xs[j] = points[nodes[j]].x;
+        ys[j] = points[nodes[j]].y;
+    }
+
+    // the coordinate kernels only apply if the planar distances are the weights of the graph
+    bool is_euclidean = true;
+    for (size_t j = 0; j < size; ++j) {
+        const auto& c = points[nodes[j]];
+        const auto& d = points[nodes[j + 1]];
+        edge_weights[j] = point_reader->distance(nodes[j], nodes[j + 1]);
+        is_euclidean = is_euclidean && edge_weights[j] == distance::euclidean_distance(c, d);
+    }
+
+    std::vector<int> gains(size);
+    std::vector<int> expected_gains(size);
+
+    // run sweep(i, gains) for every position i in turn until min_duration expires, and print
+    // the moves evaluated per second. Return false if some gains differ from scalar_sweep.
+    const auto measure = [&](const char* name, const auto& sweep, const auto& scalar_sweep) {
+        size_t n_sweeps = 0;
+        bool is_correct = true;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration::zero();
+        do {
+            const size_t i = n_sweeps % size;
+            sweep(i, gains.data());
+            ++n_sweeps;
+
+            // check a few sweeps only, so that the check doesn't affect the measure
+            if (n_sweeps <= 16) {
+                scalar_sweep(i, expected_gains.data());
+                is_correct = is_correct && std::equal(gains.cbegin(), gains.cend(),
+                                                      expected_gains.cbegin());
+            }
+
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < min_duration);
+
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        const double moves_per_second = static_cast<double>(n_sweeps * size) / seconds;
+
+        std::cout << name << ": " << std::fixed << moves_per_second / 1e6
+                  << " million moves/s" << (is_correct ? "" : ", gains MISMATCH") << std::endl;
+        return is_correct;
+    };
+
+    bool is_correct = true;
+
+    if (size <= max_matrix_size) {
+        const auto distance_matrix = point_reader->create_distance_matrix();
+
+        const auto matrix_sweep = [&](const auto kernel) {
+            return [&distance_matrix, &nodes, &edge_weights, kernel, size](const size_t i,
+                                                                           int* sweep_gains) {
+                kernel(distance_matrix.row(nodes[i]), distance_matrix.row(nodes[i + 1]),
+                       edge_weights[i], nodes.data(), edge_weights.data(), size, sweep_gains);
+            };
+        };
+
+        const auto scalar = matrix_sweep(two_opt_gains::matrix_gains_scalar);
+        is_correct &= measure("matrix scalar", scalar, scalar);
+        is_correct &= measure("matrix vectorized", matrix_sweep(two_opt_gains::matrix_gains),
+                              scalar);
+    } else {
+        std::cout << "matrix: skipped, more than " << max_matrix_size << " nodes" << std::endl;
+    }
+
+    if (is_euclidean) {
+        const auto coordinate_sweep = [&](const auto kernel) {
+            return [&points, &nodes, &xs, &ys, &edge_weights, kernel, size](const size_t i,
+                                                                            int* sweep_gains) {
+                kernel(points[nodes[i]], points[nodes[i + 1]], edge_weights[i], xs.data(),
+                       ys.data(), edge_weights.data(), size, sweep_gains);
+            };
+        };
+
+        const auto scalar = coordinate_sweep(two_opt_gains::coordinate_gains_scalar);
+        is_correct &= measure("coordinates scalar", scalar, scalar);
+        is_correct &= measure("coordinates vectorized",
+                              coordinate_sweep(two_opt_gains::coordinate_gains), scalar);
+    } else {
+        std::cout << "coordinates: skipped, the graph isn't EUC_2D" << std::endl;
+    }
+
+    return is_correct ? 0 : 1;
+}